@@ -1,4 +1,5 @@
 #include "Appetizer.hpp"
+#include "DietaryRules.hpp"
 
 /**
  * Default constructor.
@@ -79,7 +80,7 @@ and vegetarian status.
 */
 void Appetizer::display() const
 {
-    std::cout << "Dish Name: " << getName() << std::endl;
+    std::cout << "Dish Name: " << getName() << '\n';
     std::cout << "Ingredients: ";
     for (size_t i = 0; i < getIngredients().size(); ++i) {
         std::cout << getIngredients()[i].name;
@@ -87,32 +88,32 @@ void Appetizer::display() const
             std::cout << ", ";
         }
     }
-    std::cout << std::endl;
-    std::cout << "Preparation Time: " << getPrepTime() << " minutes" << std::endl;
-    std::cout << std::fixed << std::setprecision(2) << "Price: $" << getPrice() << std::endl;
-    std::cout << "Cuisine Type: " << getCuisineType() << std::endl;
+    std::cout << '\n';
+    std::cout << "Preparation Time: " << getPrepTime() << " minutes" << '\n';
+    std::cout << std::fixed << std::setprecision(2) << "Price: $" << getPrice() << '\n';
+    std::cout << "Cuisine Type: " << getCuisineType() << '\n';
     std::cout << "Serving Style: ";
     switch (serving_style_)
     {
     case PLATED:
-        std::cout << "Plated" << std::endl;
+        std::cout << "Plated" << '\n';
         break;
     case FAMILY_STYLE:
-        std::cout << "Family Style" << std::endl;
+        std::cout << "Family Style" << '\n';
         break;
     case BUFFET:
-        std::cout << "Buffet" << std::endl;
+        std::cout << "Buffet" << '\n';
         break;
     }
-    std::cout << "Spiciness Level: " << spiciness_level_ << std::endl;
+    std::cout << "Spiciness Level: " << spiciness_level_ << '\n';
     std::cout << "Vegetarian: ";
     if (vegetarian_)
     {
-        std::cout << "Yes" << std::endl;
+        std::cout << "Yes" << '\n';
     }
     else
     {
-        std::cout << "No" << std::endl;
+        std::cout << "No" << '\n';
     }
 
 }
@@ -143,42 +144,13 @@ void Appetizer::dietaryAccommodations(const DietaryRequest &request)
     if (request.vegetarian)
     {
         vegetarian_ = true;
-        bool first_replacement_done = false;
-        bool second_replacement_done = false;
-        
-        // Create a local mutable copy of the ingredients
-        std::vector<Ingredient> ingredients = getIngredients(); 
+    }
 
-        if (!ingredients.empty())
-        {
-            for (size_t i = 0; i < ingredients.size(); i++)
-            {
-                if (ingredients[i].name == "Meat" || ingredients[i].name == "Chicken" || ingredients[i].name == "Fish" || 
-                    ingredients[i].name == "Beef" || ingredients[i].name == "Pork" || ingredients[i].name == "Lamb" || 
-                    ingredients[i].name == "Shrimp" || ingredients[i].name == "Bacon")
-                {
-                    if (!first_replacement_done)
-                    {
-                        ingredients[i].name = "Beans";  // First replacement
-                        first_replacement_done = true;
-                    }
-                    else if (!second_replacement_done)
-                    {
-                        ingredients[i].name = "Mushrooms";  // Second replacement
-                        second_replacement_done = true;
-                    }
-                    else
-                    {
-                        ingredients.erase(ingredients.begin() + i);  // Remove non-vegetarian item
-                        i--;  // Adjust index after removal
-                    }
-                }
-            }
-        }
+    // one pass over the ingredients: the first two non-vegetarian ones become "Beans" and "Mushrooms"
+    // and the rest are removed, and gluten-containing ones are removed
+    applyIngredientRules(request.vegetarian ? DietaryRules::MEAT : 0,
+                         request.gluten_free ? DietaryRules::GLUTEN : 0);
 
-        // Set the modified ingredients back, assuming a setter method is available
-        setIngredients(ingredients);
-    }
     if (request.low_sodium)
     {
         spiciness_level_ -=2;
@@ -187,25 +159,4 @@ void Appetizer::dietaryAccommodations(const DietaryRequest &request)
             spiciness_level_ = 0;
         }
     }
-    if (request.gluten_free)
-    {
-        std::vector<Ingredient> ingredients = getIngredients(); // Make a copy since getIngredients() is const
-
-        if (!ingredients.empty())
-        {
-            for (size_t i = 0; i < ingredients.size(); i++)
-            {
-                if (ingredients[i].name == "Wheat" || ingredients[i].name == "Flour" || ingredients[i].name == "Bread" || 
-                    ingredients[i].name == "Pasta" || ingredients[i].name == "Barley" || ingredients[i].name == "Rye" || 
-                    ingredients[i].name == "Oats" || ingredients[i].name == "Crust")
-                {
-                    ingredients.erase(ingredients.begin() + i);
-                    i--;  // Adjust the index after erasing
-                }
-            }
-        }
-
-        // Set the modified ingredients back, assuming you have a setter or similar method
-        setIngredients(ingredients);
-    }
 }
\ No newline at end of file
@@ -0,0 +1,144 @@
+#include "BackupInventory.hpp"
+#include <algorithm>
+
+BackupInventory::BackupInventory() : next_sequence_(0) {
+}
+
+BackupInventory::Shard& BackupInventory::shardOf(int ingredient_id) {
+    return shards_[static_cast<unsigned>(ingredient_id) % SHARD_COUNT];
+}
+
+const BackupInventory::Shard& BackupInventory::shardOf(int ingredient_id) const {
+    return shards_[static_cast<unsigned>(ingredient_id) % SHARD_COUNT];
+}
+
+void BackupInventory::assign(const std::vector<Ingredient>& ingredients) {
+    clear();
+    for (const Ingredient& ingredient : ingredients) {
+        Entry entry{next_sequence_++, ingredient};
+        entry.ingredient.id = SymbolTable::ingredients().intern(ingredient.name);
+        Shard& shard = shardOf(entry.ingredient.id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.entries[entry.ingredient.id].push_back(entry);
+    }
+}
+
+void BackupInventory::add(const Ingredient& ingredient) {
+    int id = SymbolTable::ingredients().intern(ingredient.name);
+    Shard& shard = shardOf(id);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    std::deque<Entry>& entries = shard.entries[id];
+    if (!entries.empty()) {
+        entries.front().ingredient.quantity += ingredient.quantity;
+        return;
+    }
+    entries.push_back(Entry{next_sequence_++, ingredient});
+    entries.back().ingredient.id = id;
+}
+
+void BackupInventory::clear() {
+    for (Shard& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.entries.clear();
+    }
+}
+
+int BackupInventory::available(int ingredient_id) const {
+    const Shard& shard = shardOf(ingredient_id);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto found = shard.entries.find(ingredient_id);
+    return (found == shard.entries.end() || found->second.empty()) ? 0 : found->second.front().ingredient.quantity;
+}
+
+bool BackupInventory::take(int ingredient_id, int quantity) {
+    return takeAll({{ingredient_id, quantity}});
+}
+
+bool BackupInventory::takeAll(const std::vector<std::pair<int, int>>& amounts) {
+    // total per ingredient, then lock the shards involved in index order so two callers can't deadlock
+    std::vector<std::pair<int, int>> totals;
+    std::vector<int> shard_indexes;
+    for (const std::pair<int, int>& amount : amounts) {
+        if (amount.first < 0) {
+            return false;
+        }
+        auto total = std::find_if(totals.begin(), totals.end(),
+                                  [&amount](const std::pair<int, int>& t) { return t.first == amount.first; });
+        if (total == totals.end()) {
+            totals.push_back(amount);
+            shard_indexes.push_back(amount.first % SHARD_COUNT);
+        } else {
+            total->second += amount.second;
+        }
+    }
+    std::sort(shard_indexes.begin(), shard_indexes.end());
+    shard_indexes.erase(std::unique(shard_indexes.begin(), shard_indexes.end()), shard_indexes.end());
+    std::vector<std::unique_lock<std::mutex>> locks;
+    locks.reserve(shard_indexes.size());
+    for (int index : shard_indexes) {
+        locks.emplace_back(shards_[index].mutex);
+    }
+
+    // validate everything before anything is deducted
+    std::vector<std::deque<Entry>*> drawn;
+    drawn.reserve(totals.size());
+    for (const std::pair<int, int>& total : totals) {
+        Shard& shard = shardOf(total.first);
+        auto found = shard.entries.find(total.first);
+        if (found == shard.entries.end() || found->second.empty() ||
+            found->second.front().ingredient.quantity < total.second) {
+            return false;
+        }
+        drawn.push_back(&found->second);
+    }
+    for (size_t i = 0; i < totals.size(); i++) {
+        Ingredient& first = drawn[i]->front().ingredient;
+        first.quantity -= totals[i].second;
+        if (first.quantity == 0) {
+            drawn[i]->pop_front(); // used up, the next entry of the same name (if any) takes over
+            if (drawn[i]->empty()) {
+                shardOf(totals[i].first).entries.erase(totals[i].first);
+            }
+        }
+    }
+    return true;
+}
+
+void BackupInventory::forEach(const std::function<void(const Ingredient&)>& visit) const {
+    // hold every shard while the entries are put back in list order, pointing at them rather than copying
+    std::vector<std::unique_lock<std::mutex>> locks;
+    locks.reserve(SHARD_COUNT);
+    for (const Shard& shard : shards_) {
+        locks.emplace_back(shard.mutex);
+    }
+    std::vector<const Entry*> ordered;
+    for (const Shard& shard : shards_) {
+        for (const auto& ingredient_entries : shard.entries) {
+            for (const Entry& entry : ingredient_entries.second) {
+                ordered.push_back(&entry);
+            }
+        }
+    }
+    std::sort(ordered.begin(), ordered.end(),
+              [](const Entry* a, const Entry* b) { return a->sequence < b->sequence; });
+    for (const Entry* entry : ordered) {
+        visit(entry->ingredient);
+    }
+}
+
+std::vector<Ingredient> BackupInventory::snapshot() const {
+    std::vector<Ingredient> ingredients;
+    forEach([&ingredients](const Ingredient& ingredient) { ingredients.push_back(ingredient); });
+    return ingredients;
+}
+
+size_t BackupInventory::size() const {
+    size_t count = 0;
+    for (const Shard& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (const auto& ingredient_entries : shard.entries) {
+            count += ingredient_entries.second.size();
+        }
+    }
+    return count;
+}
@@ -0,0 +1,105 @@
+// Backup stock of ingredients that stations are topped up from. Entries are hashed by interned
+// ingredient ID into a fixed number of shards, each with its own lock, so station workers drawing
+// different ingredients at the same time don't wait on each other. Every entry carries the sequence
+// number it was added with, which keeps the list order of the old vector-based backup for display.
+
+#ifndef BACKUPINVENTORY_HPP
+#define BACKUPINVENTORY_HPP
+
+#include "Dish.hpp"
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class BackupInventory {
+public:
+    BackupInventory();
+
+    BackupInventory(const BackupInventory&) = delete;
+    BackupInventory& operator=(const BackupInventory&) = delete;
+
+    /**
+     * Replaces the whole stock.
+     * @param ingredients The new entries, in order. A name listed twice keeps two entries; the first is
+     * drawn from and added to until it is used up.
+     * @post: Every entry's `id` is interned from its name.
+     */
+    void assign(const std::vector<Ingredient>& ingredients);
+
+    /**
+     * @param ingredient Added to the quantity of the first entry with the same name, or as a new last entry.
+     */
+    void add(const Ingredient& ingredient);
+
+    /**
+     * @post: The stock is empty.
+     */
+    void clear();
+
+    /**
+     * @param ingredient_id The ingredient's interned name.
+     * @return: The quantity of the ingredient's first entry, 0 if there is none.
+     */
+    int available(int ingredient_id) const;
+
+    /**
+     * Draws from one ingredient.
+     * @param ingredient_id The ingredient's interned name.
+     * @param quantity The amount to draw, more than 0.
+     * @post: On success the amount is deducted from the first entry, which is removed once it reaches 0.
+     * @return: True if the first entry held at least quantity; false (and nothing changes) otherwise.
+     */
+    bool take(int ingredient_id, int quantity);
+
+    /**
+     * Draws from several ingredients at once, or from none of them. Only the shards of the listed
+     * ingredients are locked.
+     * @param amounts (ingredient ID, amount) pairs. An ID may appear more than once; its amounts add up.
+     * @post: As take() for every pair, if all of them can be covered; otherwise nothing changes.
+     * @return: True if every amount was drawn.
+     */
+    bool takeAll(const std::vector<std::pair<int, int>>& amounts);
+
+    /**
+     * Visits every entry in list order without copying them.
+     * @param visit Called with each entry. It must not call back into the inventory.
+     */
+    void forEach(const std::function<void(const Ingredient&)>& visit) const;
+
+    /**
+     * @return: A copy of every entry, in list order.
+     */
+    std::vector<Ingredient> snapshot() const;
+
+    /**
+     * @return: The number of entries.
+     */
+    size_t size() const;
+
+private:
+    static const int SHARD_COUNT = 16;
+
+    struct Entry {
+        uint64_t sequence; // when the entry was added, orders entries across shards
+        Ingredient ingredient;
+    };
+
+    // one ingredient's entries live in one shard, first entry first
+    struct Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<int, std::deque<Entry>> entries;
+    };
+
+    Shard& shardOf(int ingredient_id);
+    const Shard& shardOf(int ingredient_id) const;
+
+    Shard shards_[SHARD_COUNT];
+    std::atomic<uint64_t> next_sequence_;
+};
+
+#endif // BACKUPINVENTORY_HPP
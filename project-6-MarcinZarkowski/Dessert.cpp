@@ -1,4 +1,5 @@
 #include "Dessert.hpp"
+#include "DietaryRules.hpp"
 
 /**
  * Default constructor.
@@ -76,7 +77,7 @@ and whether it contains nuts.
 */
 void Dessert::display() const
 {
-    std::cout << "Dish Name: " << getName() << std::endl;
+    std::cout << "Dish Name: " << getName() << '\n';
     std::cout << "Ingredients: ";
     for (size_t i = 0; i < getIngredients().size(); ++i) {
         std::cout << getIngredients()[i].name;
@@ -84,42 +85,42 @@ void Dessert::display() const
             std::cout << ", ";
         }
     }
-    std::cout << std::endl;
-    std::cout << "Preparation Time: " << getPrepTime() << " minutes" << std::endl;
-    std::cout << std::fixed << std::setprecision(2) << "Price: $" << getPrice() << std::endl;
-    std::cout << "Cuisine Type: " << getCuisineType() << std::endl;
+    std::cout << '\n';
+    std::cout << "Preparation Time: " << getPrepTime() << " minutes" << '\n';
+    std::cout << std::fixed << std::setprecision(2) << "Price: $" << getPrice() << '\n';
+    std::cout << "Cuisine Type: " << getCuisineType() << '\n';
     std::cout << "Flavor Profile: ";
     // enum FlavorProfile { SWEET, BITTER, SOUR, SALTY, UMAMI };
     switch (flavor_profile_)
     {
     case SWEET:
-        std::cout << "SWEET" << std::endl;
+        std::cout << "SWEET" << '\n';
         break;
     case BITTER:
-        std::cout << "BITTER" << std::endl;
+        std::cout << "BITTER" << '\n';
         break;
     case SOUR:
-        std::cout << "SOUR" << std::endl;
+        std::cout << "SOUR" << '\n';
         break;
     case SALTY:
-        std::cout << "SALTY" << std::endl;
+        std::cout << "SALTY" << '\n';
         break;
     case UMAMI:
-        std::cout << "UMAMI" << std::endl;
+        std::cout << "UMAMI" << '\n';
         break;
     default:
-        std::cout << "UNKNOWN" << std::endl;
+        std::cout << "UNKNOWN" << '\n';
         break;
     }
-    std::cout << "Sweetness Level: " << sweetness_level_ << std::endl;
+    std::cout << "Sweetness Level: " << sweetness_level_ << '\n';
     std::cout << "Contains Nuts: ";
     if (contains_nuts_)
     {
-        std::cout << "Yes" << std::endl;
+        std::cout << "Yes" << '\n';
     }
     else
     {
-        std::cout << "No" << std::endl;
+        std::cout << "No" << '\n';
     }
 }
 
@@ -146,28 +147,12 @@ void Dessert::dietaryAccommodations(const DietaryRequest &request)
     if (request.nut_free)
     {
         contains_nuts_ = false;
-        
-        // Create a local mutable copy of ingredients
-        std::vector<Ingredient> ingredients = getIngredients();
-
-        if (!ingredients.empty())
-        {
-            for (size_t i = 0; i < ingredients.size(); ++i)
-            {
-                if (ingredients[i].name == "Almonds" || ingredients[i].name == "Walnuts" || ingredients[i].name == "Pecans" || 
-                    ingredients[i].name == "Hazelnuts" || ingredients[i].name == "Peanuts" || ingredients[i].name == "Cashews" || 
-                    ingredients[i].name == "Pistachios")
-                {
-                    ingredients.erase(ingredients.begin() + i);
-                    i--;  // Adjust index after erase
-                }
-            }
-        }
-
-        // Set the modified ingredients back
-        setIngredients(ingredients);
     }
 
+    // one pass over the ingredients removes the nuts and the dairy and egg ones that were asked for
+    applyIngredientRules(0, (request.nut_free ? DietaryRules::NUT : 0) |
+                            (request.vegan ? DietaryRules::DAIRY_OR_EGG : 0));
+
     if (request.low_sugar)
     {
         sweetness_level_ -= 3;
@@ -176,28 +161,4 @@ void Dessert::dietaryAccommodations(const DietaryRequest &request)
             sweetness_level_ = 0;
         }
     }
-
-    if (request.vegan)
-    {
-        // Create a local mutable copy of ingredients
-        std::vector<Ingredient> ingredients = getIngredients();
-
-        if (!ingredients.empty())
-        {
-            for (size_t i = 0; i < ingredients.size(); ++i)
-            {
-                if (ingredients[i].name == "Milk" || ingredients[i].name == "Eggs" || ingredients[i].name == "Cheese" || 
-                    ingredients[i].name == "Butter" || ingredients[i].name == "Cream" || ingredients[i].name == "Yogurt")
-                {
-                    ingredients.erase(ingredients.begin() + i);
-                    i--;  // Adjust index after erase
-                }
-            }
-        }
-
-        // Set the modified ingredients back
-        setIngredients(ingredients);
-    }
-
-    
 }
\ No newline at end of file
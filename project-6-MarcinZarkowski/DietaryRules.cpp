@@ -0,0 +1,70 @@
+#include "DietaryRules.hpp"
+#include <initializer_list>
+#include <utility>
+
+DietaryRules::DietaryRules() {
+    auto mark = [this](uint8_t bit, std::initializer_list<const char*> names) {
+        for (int id : SymbolTable::ingredients().internAll(names)) {
+            if (id >= static_cast<int>(classes_.size())) {
+                classes_.resize(id + 1, 0);
+            }
+            classes_[id] |= bit;
+        }
+    };
+    mark(MEAT, {"Meat", "Chicken", "Fish", "Beef", "Pork", "Lamb", "Shrimp", "Bacon"});
+    mark(DAIRY_OR_EGG, {"Milk", "Eggs", "Cheese", "Butter", "Cream", "Yogurt"});
+    mark(GLUTEN, {"Wheat", "Flour", "Bread", "Pasta", "Barley", "Rye", "Oats", "Crust"});
+    mark(NUT, {"Almonds", "Walnuts", "Pecans", "Hazelnuts", "Peanuts", "Cashews", "Pistachios"});
+}
+
+const DietaryRules& DietaryRules::instance() {
+    static const DietaryRules rules;
+    return rules;
+}
+
+uint8_t DietaryRules::classesOf(int ingredient_id) const {
+    if (ingredient_id < 0 || ingredient_id >= static_cast<int>(classes_.size())) {
+        return 0;
+    }
+    return classes_[ingredient_id];
+}
+
+uint8_t DietaryRules::classesOf(const int* ids, size_t count) const {
+    // branch-free so the loop vectorizes: an ID past the table is clamped to a slot and masked out
+    const uint8_t* table = classes_.data();
+    const unsigned size = static_cast<unsigned>(classes_.size());
+    uint8_t classes = 0;
+    for (size_t i = 0; i < count; i++) {
+        unsigned id = static_cast<unsigned>(ids[i]);
+        bool in_table = id < size;
+        classes |= table[in_table ? id : 0] & -static_cast<uint8_t>(in_table);
+    }
+    return classes;
+}
+
+bool DietaryRules::rewrite(std::vector<Ingredient>& ingredients, uint8_t replace, uint8_t drop) const {
+    static const char* const replacements[] = {"Beans", "Mushrooms"};
+    const size_t replacement_count = sizeof(replacements) / sizeof(replacements[0]);
+
+    size_t replaced = 0;
+    size_t kept = 0;
+    for (size_t i = 0; i < ingredients.size(); i++) {
+        uint8_t classes = classesOf(ingredients[i].id);
+        if (classes & replace) {
+            if (replaced == replacement_count) {
+                continue; // past the replacements, drop it
+            }
+            ingredients[i].name = replacements[replaced++];
+        } else if (classes & drop) {
+            continue;
+        }
+        if (kept != i) {
+            ingredients[kept] = std::move(ingredients[i]);
+        }
+        kept++;
+    }
+
+    bool changed = replaced > 0 || kept < ingredients.size();
+    ingredients.erase(ingredients.begin() + kept, ingredients.end());
+    return changed;
+}
@@ -0,0 +1,58 @@
+// Table-driven rules behind Dish::dietaryAccommodations. Every ingredient class a DietaryRequest acts
+// on (meat, dairy and egg, gluten, nuts) is one bit, and a table indexed by interned ingredient ID holds
+// each ingredient's class bits, so classifying an ingredient is one load instead of a search through a
+// list of names. A dish's ID array is classified in one sweep, and only a dish that has something to
+// change is rewritten, in a single stable pass that replaces and drops ingredients in place.
+
+#ifndef DIETARYRULES_HPP
+#define DIETARYRULES_HPP
+
+#include "Dish.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class DietaryRules {
+public:
+    // ingredient classes
+    static constexpr uint8_t MEAT = 1 << 0;         // "Meat", "Chicken", "Fish", "Beef", "Pork", "Lamb", "Shrimp", "Bacon"
+    static constexpr uint8_t DAIRY_OR_EGG = 1 << 1; // "Milk", "Eggs", "Cheese", "Butter", "Cream", "Yogurt"
+    static constexpr uint8_t GLUTEN = 1 << 2;       // "Wheat", "Flour", "Bread", "Pasta", "Barley", "Rye", "Oats", "Crust"
+    static constexpr uint8_t NUT = 1 << 3;          // "Almonds", "Walnuts", "Pecans", "Hazelnuts", "Peanuts", "Cashews", "Pistachios"
+
+    /**
+     * @return: The rules, built (and their ingredient names interned) on first use.
+     */
+    static const DietaryRules& instance();
+
+    /**
+     * @param ingredient_id An interned ingredient name.
+     * @return: The classes the ingredient belongs to, or 0 for none.
+     */
+    uint8_t classesOf(int ingredient_id) const;
+
+    /**
+     * @param ids Interned ingredient names, e.g. Dish::getIngredientIds().
+     * @param count The number of IDs.
+     * @return: The union of the classes of every ID.
+     */
+    uint8_t classesOf(const int* ids, size_t count) const;
+
+    /**
+     * Rewrites a list of ingredients in one stable pass.
+     * @param ingredients The ingredients, with their interned `id`s set.
+     * @param replace Classes whose first two ingredients are renamed "Beans" and "Mushrooms"
+     * (keeping their quantities) and whose later ones are dropped.
+     * @param drop Classes whose ingredients are dropped.
+     * @post: The other ingredients keep their order. Renamed ingredients keep their old `id`.
+     * @return: True if any ingredient was renamed or dropped.
+     */
+    bool rewrite(std::vector<Ingredient>& ingredients, uint8_t replace, uint8_t drop) const;
+
+private:
+    DietaryRules();
+
+    std::vector<uint8_t> classes_; // indexed by ingredient ID; IDs past the end belong to no class
+};
+
+#endif // DIETARYRULES_HPP
@@ -1,25 +1,39 @@
 #include "Dish.hpp"
+#include "DietaryRules.hpp"
 
 // Default Constructor
 Dish::Dish() 
-    : name_("UNKNOWN"), ingredients_({}), prep_time_(0), price_(0.0), cuisine_type_(CuisineType::OTHER) {
+    : name_("UNKNOWN"), name_id_(SymbolTable::dishes().intern("UNKNOWN")), ingredients_({}), prep_time_(0), price_(0.0), cuisine_type_(CuisineType::OTHER) {
 }
 
 // Parameterized Constructor
 Dish::Dish(const std::string& name, const std::vector<Ingredient>& ingredients, int prep_time, double price, CuisineType cuisine_type)
     : ingredients_(ingredients), prep_time_(prep_time), price_(price), cuisine_type_(cuisine_type) {
     setName(name);  // Use setName to validate the name
+    internIngredients();
 }
 
 // Accessor Functions
-std::string Dish::getName() const {
+const std::string& Dish::getName() const {
     return name_;
 }
 
-std::vector<Ingredient> Dish::getIngredients() const {
+int Dish::getNameId() const {
+    return name_id_;
+}
+
+const std::vector<Ingredient>& Dish::getIngredients() const {
     return ingredients_;
 }
 
+const std::vector<int>& Dish::getIngredientIds() const {
+    return ingredient_ids_;
+}
+
+const std::vector<int>& Dish::getRequiredQuantities() const {
+    return required_quantities_;
+}
+
 int Dish::getPrepTime() const {
     return prep_time_;
 }
@@ -47,10 +61,12 @@ void Dish::setName(const std::string& name) {
     } else {
         name_ = "UNKNOWN";
     }
+    name_id_ = SymbolTable::dishes().intern(name_);
 }
 
 void Dish::setIngredients(const std::vector<Ingredient>& ingredients) {
     ingredients_ = ingredients;
+    internIngredients();
 }
 
 void Dish::setPrepTime(const int& prep_time) {
@@ -91,11 +107,38 @@ bool Dish::isValidName(const std::string& name) const {
     return true;  // Name is valid
 }
 
+std::atomic<uint64_t> Dish::recipe_version_(0);
+
+uint64_t Dish::recipeVersion() {
+    return recipe_version_.load(std::memory_order_acquire);
+}
+
+void Dish::internIngredients() {
+    SymbolTable& table = SymbolTable::ingredients();
+    ingredient_ids_.clear();
+    required_quantities_.clear();
+    for (Ingredient& ingredient : ingredients_) {
+        ingredient.id = table.intern(ingredient.name);
+        ingredient_ids_.push_back(ingredient.id);
+        required_quantities_.push_back(ingredient.required_quantity);
+    }
+    recipe_version_.fetch_add(1, std::memory_order_release);
+}
+
 bool Dish::operator==(const Dish& rhs) const {
-    return name_ == rhs.name_ && prep_time_ == rhs.prep_time_ && 
+    return name_id_ == rhs.name_id_ && prep_time_ == rhs.prep_time_ && 
     price_ == rhs.price_ && cuisine_type_ == rhs.cuisine_type_;
 }
 
 bool Dish::operator!=(const Dish& rhs) const {
     return !(*this == rhs);
-}
\ No newline at end of file
+}
+// Ingredient class checks, the ID lists are interned once on first use
+void Dish::applyIngredientRules(uint8_t replace, uint8_t drop) {
+    const DietaryRules& rules = DietaryRules::instance();
+    if ((rules.classesOf(ingredient_ids_.data(), ingredient_ids_.size()) & (replace | drop)) == 0) {
+        return; // nothing to replace or drop
+    }
+    rules.rewrite(ingredients_, replace, drop);
+    internIngredients();
+}
@@ -6,6 +6,9 @@
 #include <iostream>
 #include <iomanip> // For std::fixed and std::setprecision
 #include <cctype>  // For std::isalpha, std::isspace
+#include <cstdint>
+#include <atomic>
+#include "SymbolTable.hpp"
 
 /**
  * Struct representing an ingredient.
@@ -15,11 +18,12 @@ struct Ingredient {
     int quantity;            // Quantity in stock
     int required_quantity;   // Quantity required for a dish
     double price;            // Price per unit
+    int id;                  // Interned name (SymbolTable::ingredients()), set by the dish or station that stores it
 
     // Constructors
-    Ingredient() : name("UNKNOWN"), quantity(0), required_quantity(0), price(0.0) {}
+    Ingredient() : name("UNKNOWN"), quantity(0), required_quantity(0), price(0.0), id(SymbolTable::NO_ID) {}
     Ingredient(const std::string& name, const int& quantity, const int& required_quantity, const double& price)
-        : name(name), quantity(quantity), required_quantity(required_quantity), price(price) {}
+        : name(name), quantity(quantity), required_quantity(required_quantity), price(price), id(SymbolTable::NO_ID) {}
 };
 class Dish {
 public:
@@ -63,14 +67,37 @@ public:
 
     // Accessors
     /**
-     * @return The name of the dish.
+     * @return A reference to the name of the dish, valid until the name is changed.
      */
-    std::string getName() const;
+    const std::string& getName() const;
 
     /**
-     * @return The list of ingredients used in the dish.
+     * @return The interned ID of the dish name (SymbolTable::dishes()).
      */
-    std::vector<Ingredient> getIngredients() const;
+    int getNameId() const;
+
+    /**
+     * @return A reference to the list of ingredients used in the dish, each with its interned `id` set.
+     * The reference is valid until the ingredients are changed.
+     */
+    const std::vector<Ingredient>& getIngredients() const;
+
+    /**
+     * @return The interned ID of each ingredient, in the same order as getIngredients().
+     * Kept next to getRequiredQuantities() so a recipe can be checked against stock with vector loads.
+     */
+    const std::vector<int>& getIngredientIds() const;
+
+    /**
+     * @return The required quantity of each ingredient, in the same order as getIngredients().
+     */
+    const std::vector<int>& getRequiredQuantities() const;
+
+    /**
+     * @return A number that goes up whenever any dish's recipe is set or changed (including by a dietary
+     * accommodation), so something that caches facts about recipes can tell when to recompute them.
+     */
+    static uint64_t recipeVersion();
 
     /**
      * @return The preparation time in minutes.
@@ -98,7 +125,7 @@ public:
     /**
      * Sets the list of ingredients.
      * @param ingredients A reference to the new list of ingredients.
-     * @post Sets the private member `ingredients_` to the value of the parameter.
+     * @post Sets the private member `ingredients_` to the value of the parameter and interns each ingredient name.
      */
     void setIngredients(const std::vector<Ingredient>& ingredients);
 
@@ -163,9 +190,18 @@ public:
     */
     virtual void dietaryAccommodations(const DietaryRequest& request) = 0;
 
+protected:
+    // Used by the dietary accommodations: rewrites the ingredients in one pass with DietaryRules::rewrite
+    // (the first two in a `replace` class become "Beans" and "Mushrooms", later ones and those in a `drop`
+    // class are removed). The ingredients are only touched if one of them is in one of the classes.
+    void applyIngredientRules(uint8_t replace, uint8_t drop);
+
 private:
     std::string name_;
+    int name_id_;
     std::vector<Ingredient> ingredients_;
+    std::vector<int> ingredient_ids_;        // ingredients_[i].id
+    std::vector<int> required_quantities_;   // ingredients_[i].required_quantity
     int prep_time_;
     double price_;
     CuisineType cuisine_type_;
@@ -177,6 +213,12 @@ private:
      * @return True if the name contains only alphabetic characters and spaces; false otherwise.
      */
     bool isValidName(const std::string& name) const;
+
+    // Sets the interned `id` of every ingredient in `ingredients_` and rebuilds the recipe arrays.
+    // Every change a dish makes to its own recipe goes through here, so it also bumps recipe_version_.
+    void internIngredients();
+
+    static std::atomic<uint64_t> recipe_version_;
 };
 
 #endif // DISH_HPP
@@ -0,0 +1,37 @@
+#include "DishArena.hpp"
+
+DishArena::DishArena() : block_used_(0) {
+}
+
+DishArena::~DishArena() {
+    release();
+}
+
+void DishArena::release() {
+    for (auto it = made_.rbegin(); it != made_.rend(); ++it) {
+        it->destroy(it->object);
+    }
+    made_.clear();
+
+    // keep the first block so the next shift starts without allocating
+    if (blocks_.size() > 1) {
+        blocks_.resize(1);
+    }
+    block_used_ = 0;
+}
+
+size_t DishArena::size() const {
+    return made_.size();
+}
+
+void* DishArena::allocate(size_t size, size_t alignment) {
+    size_t offset = (block_used_ + alignment - 1) / alignment * alignment;
+    if (blocks_.empty() || offset + size > blocks_.back().capacity) {
+        // new[] memory is aligned for any fundamental type, which covers every dish
+        size_t capacity = (size > BLOCK_SIZE) ? size : BLOCK_SIZE;
+        blocks_.push_back({std::unique_ptr<unsigned char[]>(new unsigned char[capacity]), capacity});
+        offset = 0;
+    }
+    block_used_ = offset + size;
+    return blocks_.back().memory.get() + offset;
+}
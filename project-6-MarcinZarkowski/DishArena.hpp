@@ -0,0 +1,90 @@
+// Per-shift arena for dishes. Dishes are constructed side by side in large blocks the arena owns,
+// instead of one heap allocation each, and are all destroyed together by release() at the end of the
+// shift (or when the arena goes away). The arena is the one owner of its dishes: stations, the
+// preparation queue and the backup only hold plain Dish* into it and never delete them.
+//
+// release() runs each dish's own destructor, newest first, so a dish may refer to dishes made before
+// it. The first block is kept for the next shift; a dish bigger than BLOCK_SIZE gets a block of its own.
+
+#ifndef DISHARENA_HPP
+#define DISHARENA_HPP
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+class DishArena {
+public:
+    // bytes per block; a dish bigger than this gets a block of its own
+    static const size_t BLOCK_SIZE = 16 * 1024;
+
+    DishArena();
+
+    /**
+     * Destructor.
+     * @post: Every dish made by the arena is destroyed, as by release().
+     */
+    ~DishArena();
+
+    DishArena(const DishArena&) = delete;
+    DishArena& operator=(const DishArena&) = delete;
+
+    /**
+     * Constructs a dish in the arena.
+     * @param args The arguments of T's constructor.
+     * @return: The dish. It stays valid until release() is called or the arena is destroyed, and must
+     * not be deleted.
+     */
+    template<class T, class... Args>
+    T* make(Args&&... args);
+
+    /**
+     * Ends the shift.
+     * @pre: Nothing still uses a dish made by the arena.
+     * @post: Every dish is destroyed, newest first, and all blocks but the first are freed. The first
+     * block is kept for the next shift.
+     */
+    void release();
+
+    /**
+     * @return: The number of dishes made since the last release().
+     */
+    size_t size() const;
+
+private:
+    // returns `size` bytes aligned to `alignment` from the current block, starting a new block if needed
+    void* allocate(size_t size, size_t alignment);
+
+    template<class T>
+    static void destroy(void* object);
+
+    struct Block {
+        std::unique_ptr<unsigned char[]> memory;
+        size_t capacity;
+    };
+    struct Made {
+        void* object;
+        void (*destroy)(void*);
+    };
+
+    std::vector<Block> blocks_;
+    size_t block_used_;      // bytes used in blocks_.back()
+    std::vector<Made> made_; // in order of construction
+};
+
+template<class T, class... Args>
+T* DishArena::make(Args&&... args) {
+    void* memory = allocate(sizeof(T), alignof(T));
+    T* dish = new (memory) T(std::forward<Args>(args)...);
+    made_.push_back({dish, &DishArena::destroy<T>});
+    return dish;
+}
+
+template<class T>
+void DishArena::destroy(void* object) {
+    static_cast<T*>(object)->~T();
+}
+
+#endif // DISHARENA_HPP
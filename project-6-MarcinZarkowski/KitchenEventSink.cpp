@@ -0,0 +1,7 @@
+#include "KitchenEventSink.hpp"
+
+KitchenEventSink::~KitchenEventSink() {
+}
+
+void KitchenEventSink::flush() {
+}
@@ -0,0 +1,47 @@
+// Where StationManager reports what happens while it works through the dish queue. Each step (a dish
+// is started, a station attempts it, runs short, is replenished, prepares it, ...) is one small
+// fixed-size event holding interned IDs instead of text, so producing one is cheap. What is done with
+// the events is up to the sink: TextEventSink formats them into the usual lines, RingLogEventSink keeps
+// the latest ones in binary form, and NullEventSink drops them.
+
+#ifndef KITCHENEVENTSINK_HPP
+#define KITCHENEVENTSINK_HPP
+
+#include <cstdint>
+
+class KitchenEventSink {
+public:
+    enum class EventType : uint8_t {
+        DISH_STARTED,       // a dish is taken from the front of the queue
+        ATTEMPTING,         // a station attempts the dish
+        NOT_CARRIED,        // the station doesn't carry the dish
+        INSUFFICIENT_STOCK, // the station is short of ingredients and asks the backup
+        REPLENISHED,        // the backup covered the station's deficits
+        REPLENISH_FAILED,   // the backup couldn't cover them
+        PREPARED,           // the station prepared the dish
+        DISH_PREPARED,      // the dish is done
+        DISH_NOT_PREPARED,  // no station could prepare the dish, it goes back in the queue
+        ALL_PROCESSED       // the queue has been worked through
+    };
+
+    struct Event {
+        EventType type;
+        int dish_id;    // interned dish name (Dish::getNameId()), SymbolTable::NO_ID for ALL_PROCESSED
+        int station_id; // interned station name (KitchenStation::getNameId()), SymbolTable::NO_ID for dish events
+    };
+
+    virtual ~KitchenEventSink();
+
+    /**
+     * @param event The event to record.
+     * @pre: Only one thread emits to a sink at a time.
+     */
+    virtual void emit(const Event& event) = 0;
+
+    /**
+     * @post: Anything the sink holds back is written out. Does nothing by default.
+     */
+    virtual void flush();
+};
+
+#endif // KITCHENEVENTSINK_HPP
@@ -1,32 +1,37 @@
 #include "KitchenStation.hpp"
+#include <algorithm>
 
 KitchenStation::KitchenStation() 
-    : station_name_("UNKNOWN"), dishes_({}), ingredients_stock_({}) {
+    : station_name_("UNKNOWN"), station_name_id_(SymbolTable::stations().intern("UNKNOWN")), dishes_({}), ingredients_stock_({}), registry_(nullptr), registry_handle_(StationRegistry::NO_HANDLE) {
 }
 
 KitchenStation::KitchenStation(const std::string& station_name) 
-    : station_name_(station_name), dishes_({}), ingredients_stock_({}) {
+    : station_name_(station_name), station_name_id_(SymbolTable::stations().intern(station_name)), dishes_({}), ingredients_stock_({}), registry_(nullptr), registry_handle_(StationRegistry::NO_HANDLE) {
 }
 
 KitchenStation::~KitchenStation() {
-    for (Dish* dish : dishes_) {
-        delete dish;
+    if (registry_ != nullptr) {
+        registry_->remove(this);
     }
 }
-std::string KitchenStation::getName() const {
+const std::string& KitchenStation::getName() const {
     return station_name_;
 }
+int KitchenStation::getNameId() const {
+    return station_name_id_;
+}
 void KitchenStation::setName(const std::string& station_name) {
     station_name_ = station_name;
+    station_name_id_ = SymbolTable::stations().intern(station_name_);
 }
 
 // get dishes
-std::vector<Dish*> KitchenStation::getDishes() const
+const std::vector<Dish*>& KitchenStation::getDishes() const
 {
     return dishes_;
 }
 // get ingredients stock
-std::vector<Ingredient> KitchenStation::getIngredientsStock() const
+const std::vector<Ingredient>& KitchenStation::getIngredientsStock() const
 {
     return ingredients_stock_;
 }
@@ -35,124 +40,260 @@ bool KitchenStation::assignDishToStation(Dish* dish) {
     if (dish == nullptr) {
         return false;
     }
-    if (isPresent(dish->getName())) {
+    if (carriesDish(dish->getNameId())) {
         return false;
     }
     else {  
         dishes_.push_back(dish);
+        dish_index_[dish->getNameId()] = dish;
+        if (registry_ != nullptr) {
+            registry_->dishAssigned(registry_handle_, dish->getNameId());
+        }
         return true;
     }
 }
 
 bool KitchenStation::isPresent(const std::string& dish_name) const {
-    for (Dish* dish : dishes_) {
-        if (dish->getName() == dish_name) {
-            return true;
-        }
+    return carriesDish(SymbolTable::dishes().lookup(dish_name));
+}
+
+bool KitchenStation::carriesDish(int dish_id) const {
+    return dish_index_.count(dish_id) > 0;
+}
+
+const Dish* KitchenStation::getDish(int dish_id) const {
+    return findDish(dish_id);
+}
+
+Dish* KitchenStation::findDish(int dish_id) const {
+    auto it = dish_index_.find(dish_id);
+    return (it == dish_index_.end()) ? nullptr : it->second;
+}
+
+Ingredient* KitchenStation::findStock(int ingredient_id) {
+    if (ingredient_id < 0 || ingredient_id >= static_cast<int>(stock_slot_.size()) || stock_slot_[ingredient_id] < 0) {
+        return nullptr;
+    }
+    return &ingredients_stock_[stock_slot_[ingredient_id]];
+}
+
+const Ingredient* KitchenStation::findStock(int ingredient_id) const {
+    if (ingredient_id < 0 || ingredient_id >= static_cast<int>(stock_slot_.size()) || stock_slot_[ingredient_id] < 0) {
+        return nullptr;
     }
-    return false;
+    return &ingredients_stock_[stock_slot_[ingredient_id]];
+}
+
+bool KitchenStation::isStocked(int ingredient_id) const {
+    std::lock_guard<std::mutex> lock(stock_mutex_);
+    return findStock(ingredient_id) != nullptr;
+}
+
+int KitchenStation::getStockQuantity(int ingredient_id) const {
+    std::lock_guard<std::mutex> lock(stock_mutex_);
+    const Ingredient* stock_ingredient = findStock(ingredient_id);
+    return (stock_ingredient == nullptr) ? 0 : stock_ingredient->quantity;
 }
 
 void KitchenStation::replenishStationIngredients(const Ingredient& ingredient) {
+    int id = SymbolTable::ingredients().intern(ingredient.name);
+    std::lock_guard<std::mutex> lock(stock_mutex_);
+    addStock(ingredient, id, ingredient.quantity);
+}
+
+void KitchenStation::addStock(const Ingredient& ingredient, int id, int quantity, int slot) {
     //check if ingredient is already in stock
-    for (Ingredient& stock_ingredient : ingredients_stock_) {
-        if (stock_ingredient.name == ingredient.name) {
-            // std::cout<< "Found ingredient "<< stock_ingredient.name << std::endl;
-            // std::cout<< "We have "<< stock_ingredient.quantity << " of "<< stock_ingredient.name << std::endl;
-            // std::cout<< "We are adding "<< ingredient.quantity << " of "<< ingredient.name << std::endl;
-            stock_ingredient.quantity += ingredient.quantity;
-            // std::cout<< "We now have "<< stock_ingredient.quantity << " of "<< stock_ingredient.name << std::endl;
-            return;
-        }
+    Ingredient* stock_ingredient = findStock(id);
+    if (stock_ingredient != nullptr) {
+        stock_ingredient->quantity += quantity;
+        quantityChanged(id, stock_ingredient->quantity);
+        return;
+    }
+    if (id >= static_cast<int>(stock_slot_.size())) {
+        stock_slot_.resize(id + 1, -1);
+        stock_quantity_.resize(id + 1, StockKernel::NOT_STOCKED);
+    }
+    if (slot < 0 || slot > static_cast<int>(ingredients_stock_.size())) {
+        slot = static_cast<int>(ingredients_stock_.size());
+    }
+    // the entries from slot on move up a slot
+    std::vector<Ingredient>::iterator entry = ingredients_stock_.insert(ingredients_stock_.begin() + slot, ingredient);
+    entry->id = id;
+    entry->quantity = quantity;
+    for (size_t i = slot; i < ingredients_stock_.size(); i++) {
+        stock_slot_[ingredients_stock_[i].id] = static_cast<int>(i);
+    }
+    quantityChanged(id, quantity);
+}
+
+void KitchenStation::quantityChanged(int ingredient_id, int quantity) {
+    stock_quantity_[ingredient_id] = quantity;
+    if (registry_ != nullptr) {
+        registry_->stockChanged(registry_handle_, ingredient_id, quantity);
     }
-    ingredients_stock_.push_back(ingredient);
 }
 
 bool KitchenStation::canCompleteOrder(const std::string& dish_name) const {
-    for (Dish* dish : dishes_) {
-        // std::cout<< "Dish name: "<< dish->getName()<<std::endl;
-        if (dish->getName() == dish_name) {
-            // std::cout << "Checking if we can complete order for " << dish_name << std::endl;
-            for (Ingredient ingredient : dish->getIngredients()) {
-                // std::cout << "Checking for ingredient " << ingredient.name << std::endl;
-                bool found = false;
-                for (Ingredient stock_ingredient : ingredients_stock_) {
-                    if (stock_ingredient.name == ingredient.name) {
-                        // std::cout<< "Found ingredient "<< stock_ingredient.name << " and we have "<< stock_ingredient.quantity << std::endl;
-                        if (stock_ingredient.quantity >= ingredient.required_quantity) {
-                            // std::cout<<"YAY We need "<< ingredient.required_quantity << " of "<< ingredient.name << " and we have "<< stock_ingredient.quantity << std::endl;
-                            // std::cout << "Found enough quantity of " << stock_ingredient.name << std::endl;
-                            found = true;
-                        }
-                        else {
-                            // std::cout << "Did not find enough quantity of " << stock_ingredient.name << std::endl;
-                            // std::cout<<"NO We need "<< ingredient.required_quantity << " of "<< ingredient.name << " and we have "<< stock_ingredient.quantity << std::endl;
-                            return false;
-                        }
-                    }
-                }
-                if (!found) {
-                    // std::cout<< "Did not find " << ingredient.name << std::endl;
-                    return false;
-                }
-            }
-            return true;
-        }
+    return canCompleteOrder(SymbolTable::dishes().lookup(dish_name));
+}
+
+bool KitchenStation::canCompleteOrder(int dish_id) const {
+    const Dish* dish = findDish(dish_id);
+    if (dish == nullptr) {
+        return false;
     }
-    return false;
+    // every recipe ingredient must be in stock with at least the required quantity
+    std::lock_guard<std::mutex> lock(stock_mutex_);
+    return StockKernel::covers(stock_quantity_.data(), static_cast<int>(stock_quantity_.size()),
+                               dish->getIngredientIds().data(), dish->getRequiredQuantities().data(),
+                               static_cast<int>(dish->getIngredientIds().size()));
 }
 
 bool KitchenStation::prepareDish(const std::string& dish_name) {
-    if (!canCompleteOrder(dish_name)) {
+    return prepareDish(SymbolTable::dishes().lookup(dish_name));
+}
+
+bool KitchenStation::prepareDish(int dish_id) {
+    Reservation reservation;
+    if (!reserveIngredients(dish_id, reservation)) {
         return false;
     }
-    else{
-        //std::cout<< "Preparing dish: "<< dish_name << std::endl;
-    }
-    for (Dish* dish : dishes_) {
-        if (dish->getName() == dish_name) {
-            // Check if we have all the ingredients and the right quantity before doing anything else
-            for (Ingredient ingredient : dish->getIngredients()) {
-                //std::cout<< "Checking for ingredient " << ingredient.name<< " "<< ingredient.quantity << std::endl;
-                bool found = false;
-                for (Ingredient& stock_ingredient : ingredients_stock_) {
-                    if (stock_ingredient.name == ingredient.name) {
-                        // Check if we have enough stock
-                        if (stock_ingredient.quantity >= ingredient.quantity) {
-                            found = true;
-                            break; // breaks out of the inner loop, so we check the next ingredient
-                        }
-                    }
-                }
-                if (!found) { // one of the ingredients is missing or not enough
-                    return false;
-                }
-                // If we reach this point, we have all the ingredients in stock. Hooray!
-            }
-            // Deduct the ingredients from stock
-            for (Ingredient ingredient : dish->getIngredients()) {
-                for (Ingredient& stock_ingredient : ingredients_stock_) {
-                    if (stock_ingredient.name == ingredient.name) {
-                        stock_ingredient.quantity -= ingredient.required_quantity;
-                        // if we have 0 quantity of an ingredient, we should remove it from stock
-                        if (stock_ingredient.quantity == 0) {
-                            removeIngredient(stock_ingredient.name);
-                        }
-                    }
-                }
+    reservation.commit();
+    return true;
+}
+
+bool KitchenStation::reserveIngredients(int dish_id, Reservation& reservation) {
+    return reserveIngredients(dish_id, 1, reservation) == 1;
+}
+
+int KitchenStation::reserveIngredients(int dish_id, int count, Reservation& reservation) {
+    const Dish* dish = findDish(dish_id);
+    if (dish == nullptr || count <= 0) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(stock_mutex_);
+    reservation.taken_.clear();
+
+    // total the recipe needs of each distinct ingredient per dish
+    std::vector<std::pair<int, int>> totals;
+    bool all_positive = true;
+    for (const Ingredient& ingredient : dish->getIngredients()) {
+        all_positive = all_positive && ingredient.required_quantity > 0;
+        auto total = std::find_if(totals.begin(), totals.end(),
+                                  [&ingredient](const std::pair<int, int>& t) { return t.first == ingredient.id; });
+        if (total == totals.end()) {
+            totals.emplace_back(ingredient.id, ingredient.required_quantity);
+        } else {
+            total->second += ingredient.required_quantity;
+        }
+    }
+
+    int reserved = 0;
+    if (all_positive) {
+        // every dish uses up stock, so the scarcest ingredient decides how many can be made
+        reserved = count;
+        for (const std::pair<int, int>& total : totals) {
+            const Ingredient* stock_ingredient = findStock(total.first);
+            int enough_for = (stock_ingredient == nullptr) ? 0 : std::max(0, stock_ingredient->quantity / total.second);
+            reserved = std::min(reserved, enough_for);
+        }
+        if (reserved > 0) {
+            for (const std::pair<int, int>& total : totals) {
+                takeStock(*findStock(total.first), reserved * total.second, reservation);
             }
-            return true;
         }
+    } else {
+        // a zero or negative requirement can leave the stock unchanged or growing, so go one dish at a time
+        while (reserved < count && takeRecipe(dish, reservation)) {
+            reserved++;
+        }
+    }
+    if (reserved > 0) {
+        reservation.station_ = this;
     }
-    return false; 
+    return reserved;
 }
 
-bool KitchenStation::removeIngredient(const std::string& ingredient_name) {
-    for (size_t i = 0; i < ingredients_stock_.size(); i++) {
-        if (ingredients_stock_[i].name == ingredient_name) {
-            ingredients_stock_.erase(ingredients_stock_.begin() + i);
-            return true;
+bool KitchenStation::takeRecipe(const Dish* dish, Reservation& reservation) {
+    // each ingredient must be there on its own first, as canCompleteOrder requires
+    if (!StockKernel::covers(stock_quantity_.data(), static_cast<int>(stock_quantity_.size()),
+                             dish->getIngredientIds().data(), dish->getRequiredQuantities().data(),
+                             static_cast<int>(dish->getIngredientIds().size()))) {
+        return false;
+    }
+    size_t first_taken = reservation.taken_.size();
+    // deduct each ingredient in turn; an ingredient listed twice can still run short, then put back what was taken
+    for (const Ingredient& ingredient : dish->getIngredients()) {
+        Ingredient* stock_ingredient = findStock(ingredient.id);
+        if (stock_ingredient == nullptr || stock_ingredient->quantity < ingredient.required_quantity) {
+            for (size_t i = reservation.taken_.size(); i > first_taken; i--) {
+                const Ingredient& taken = reservation.taken_[i - 1];
+                addStock(taken, taken.id, taken.quantity, reservation.removed_slot_[i - 1]);
+            }
+            reservation.taken_.resize(first_taken);
+            reservation.removed_slot_.resize(first_taken);
+            return false;
         }
+        takeStock(*stock_ingredient, ingredient.required_quantity, reservation);
+    }
+    return true;
+}
+
+void KitchenStation::takeStock(Ingredient& stock_ingredient, int quantity, Reservation& reservation) {
+    int id = stock_ingredient.id;
+    reservation.taken_.push_back(stock_ingredient);
+    reservation.taken_.back().quantity = quantity;
+    stock_ingredient.quantity -= quantity;
+    // if we have 0 quantity of an ingredient, we should remove it from stock
+    if (stock_ingredient.quantity == 0) {
+        reservation.removed_slot_.push_back(stock_slot_[id]);
+        removeIngredient(id);
+    } else {
+        reservation.removed_slot_.push_back(-1);
+        quantityChanged(id, stock_ingredient.quantity);
     }
-    return false;
-}
\ No newline at end of file
+}
+
+KitchenStation::Reservation::Reservation() : station_(nullptr) {
+}
+
+KitchenStation::Reservation::~Reservation() {
+    rollback();
+}
+
+bool KitchenStation::Reservation::isPending() const {
+    return station_ != nullptr;
+}
+
+void KitchenStation::Reservation::commit() {
+    station_ = nullptr;
+    taken_.clear();
+    removed_slot_.clear();
+}
+
+void KitchenStation::Reservation::rollback() {
+    if (station_ == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(station_->stock_mutex_);
+    // newest first, so each used-up entry goes back into the stock as it was when it was removed
+    for (size_t i = taken_.size(); i > 0; i--) {
+        station_->addStock(taken_[i - 1], taken_[i - 1].id, taken_[i - 1].quantity, removed_slot_[i - 1]);
+    }
+    commit();
+}
+
+bool KitchenStation::removeIngredient(int ingredient_id) {
+    if (findStock(ingredient_id) == nullptr) {
+        return false;
+    }
+    // erase the entry so the rest of the stock keeps its order; the entries after it move down a slot
+    int slot = stock_slot_[ingredient_id];
+    stock_slot_[ingredient_id] = -1;
+    ingredients_stock_.erase(ingredients_stock_.begin() + slot);
+    for (size_t i = slot; i < ingredients_stock_.size(); i++) {
+        stock_slot_[ingredients_stock_[i].id] = static_cast<int>(i);
+    }
+    quantityChanged(ingredient_id, StockKernel::NOT_STOCKED);
+    return true;
+}
@@ -1,41 +1,144 @@
 #ifndef KITCHENSTATION_HPP
+#define KITCHENSTATION_HPP
 
 #include <iostream>
 #include <vector>
 #include <string>
+#include <unordered_map>
 #include <iomanip>
 #include <cctype>
+#include <mutex>
 #include "Dish.hpp"
+#include "StationRegistry.hpp"
+#include "StockKernel.hpp"
 
 class KitchenStation {
 
     private:
         std::string station_name_;
+        int station_name_id_; // station_name_ interned in SymbolTable::stations()
         std::vector<Dish*> dishes_;
         std::vector<Ingredient> ingredients_stock_;
 
+        // indexes kept in step with dishes_ and ingredients_stock_ so lookups by interned ID don't scan
+        std::unordered_map<int, Dish*> dish_index_;     // dish name ID -> dish
+        std::vector<int> stock_slot_;                   // ingredient ID -> slot in ingredients_stock_, -1 if not stocked
+        std::vector<int> stock_quantity_;               // ingredient ID -> quantity in stock, StockKernel::NOT_STOCKED if not stocked
+
+        // keeps stock_quantity_ and the registry in step after an entry's quantity changes or it is removed
+        void quantityChanged(int ingredient_id, int quantity);
+
+        // guards the stock (ingredients_stock_, stock_slot_, stock_quantity_) so several threads can
+        // check, reserve and replenish at the same station
+        mutable std::mutex stock_mutex_;
+
+        // the registry this station reports its changes to, if any (set by StationRegistry)
+        friend class StationRegistry;
+        StationRegistry* registry_;
+        StationRegistry::Handle registry_handle_;
+
+        Dish* findDish(int dish_id) const;
+        Ingredient* findStock(int ingredient_id);
+        const Ingredient* findStock(int ingredient_id) const;
+
         bool isPresent(const std::string& dish_name) const;
-        bool removeIngredient(const std::string& ingredient_name);
+        bool removeIngredient(int ingredient_id);
+        // adds quantity to an ingredient's entry, creating the entry if needed at slot (the back if -1,
+        // stock_mutex_ held)
+        void addStock(const Ingredient& ingredient, int id, int quantity, int slot = -1);
 
     public:
+        /**
+         * The ingredients taken from a station's stock for one dish, until they are committed
+         * (the dish is made) or rolled back (the ingredients go back into stock).
+         * A reservation that is still pending when it is destroyed is rolled back.
+         */
+        class Reservation {
+            public:
+                Reservation();
+                ~Reservation();
+                Reservation(const Reservation&) = delete;
+                Reservation& operator=(const Reservation&) = delete;
+
+                // whether ingredients are held that have been neither committed nor rolled back
+                bool isPending() const;
+                // keeps the deduction; the reservation is no longer pending
+                void commit();
+                // returns every held ingredient to the station's stock, entries that were used up at their old
+                // positions; the reservation is no longer pending
+                void rollback();
+
+            private:
+                friend class KitchenStation;
+                KitchenStation* station_;        // nullptr unless pending
+                std::vector<Ingredient> taken_;  // id, name and quantity taken of each recipe ingredient
+                std::vector<int> removed_slot_;  // per taken_ entry: the stock slot it was erased from if the take used it up, else -1
+        };
+
         KitchenStation();
         KitchenStation(const std::string& station_name);
+        // leaves the registry, if any. The station doesn't own its dishes (their owner, usually the
+        // shift's DishArena, deletes them), so they are not deleted here
         ~KitchenStation();
 
         // get name of station
-        std::string getName() const;
+        const std::string& getName() const;
+        // get the station's interned name (SymbolTable::stations())
+        int getNameId() const;
         // set name of station
         void setName(const std::string& station_name);
-        // get dishes
-        std::vector<Dish*> getDishes() const;
-        // get ingredients stock
-        std::vector<Ingredient> getIngredientsStock() const;
+        // get dishes (reference is valid until a dish is assigned)
+        const std::vector<Dish*>& getDishes() const;
+        // get ingredients stock, in the order the entries were added; an ingredient used up and restocked
+        // goes to the back, one put back by a rolled-back reservation returns to where it was (reference is valid until the stock changes; only read it while no other thread
+        // changes the stock)
+        const std::vector<Ingredient>& getIngredientsStock() const;
 
         bool assignDishToStation(Dish* dish);
         void replenishStationIngredients(const Ingredient& ingredient);
         bool canCompleteOrder(const std::string& dish_name) const;
         bool prepareDish(const std::string& dish_name);
 
+        // same as above, keyed by the dish's interned name (Dish::getNameId())
+        bool carriesDish(int dish_id) const;
+        // the station's own copy of a dish (its recipe), or nullptr if the station doesn't carry it
+        const Dish* getDish(int dish_id) const;
+        bool canCompleteOrder(int dish_id) const;
+        bool prepareDish(int dish_id);
+
+        /**
+         * Takes every ingredient of a dish's recipe out of stock in a single pass, or none of them.
+         * Entries used up are removed from the stock straight away, as when a dish is prepared.
+         * Safe to call from several threads at once, alongside canCompleteOrder and replenishStationIngredients.
+         * @param dish_id The dish's interned name (Dish::getNameId()).
+         * @param reservation Receives the ingredients taken. Must not be pending.
+         * @return: True if the station carries the dish and had enough of every ingredient; false
+         * (and the stock is unchanged) otherwise.
+         */
+        bool reserveIngredients(int dish_id, Reservation& reservation);
+
+        /**
+         * Reserves the ingredients for as many of the same dish as the stock allows, up to count.
+         * The recipe is checked once: each ingredient's stock is divided by the total the recipe
+         * requires of it, and the smallest result times the requirement is taken in one go.
+         * The result is the same as reserving the dish count times in a row.
+         * @param dish_id The dish's interned name (Dish::getNameId()).
+         * @param count The most dishes to reserve for.
+         * @param reservation Receives the ingredients taken. Must not be pending.
+         * @return: The number of dishes reserved for (0 leaves the stock unchanged).
+         */
+        int reserveIngredients(int dish_id, int count, Reservation& reservation);
+        // whether an ingredient (by interned ID) has an entry in the stock
+        bool isStocked(int ingredient_id) const;
+        // quantity of an ingredient (by interned ID) in stock, 0 if not stocked
+        int getStockQuantity(int ingredient_id) const;
+
+    private:
+        // takes quantity out of an ingredient's entry into the reservation (stock_mutex_ held, entry exists)
+        void takeStock(Ingredient& stock_ingredient, int quantity, Reservation& reservation);
+        // checks and takes one dish's ingredients, or none of them (stock_mutex_ held)
+        bool takeRecipe(const Dish* dish, Reservation& reservation);
+
 };
 
 #endif // KITCHENSTATION_HPP
\ No newline at end of file
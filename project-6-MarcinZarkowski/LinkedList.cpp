@@ -15,25 +15,27 @@
 #include <cassert>
 
 // constructor
-template<class T>
-LinkedList<T>::LinkedList() : head_ptr_(nullptr), item_count_(0)
+template<class T, class Alloc>
+LinkedList<T, Alloc>::LinkedList() : head_ptr_(nullptr), tail_ptr_(nullptr), item_count_(0)
 {
 }  // end default constructor
 
 
 // copy constructor
-template<class T>
-LinkedList<T>::LinkedList(const LinkedList<T>& a_list) : item_count_(a_list.item_count_)
+template<class T, class Alloc>
+LinkedList<T, Alloc>::LinkedList(const LinkedList<T, Alloc>& a_list) : item_count_(a_list.item_count_)
 {
    Node<T>* orig_chain_pointer = a_list.head_ptr_;  // Points to nodes in original chain
 
    if (orig_chain_pointer == nullptr)
+   {
       head_ptr_ = nullptr;  // Original list is empty
+      tail_ptr_ = nullptr;
+   }
    else
    {
       // Copy first node
-      head_ptr_ = new Node<T>();
-      head_ptr_->setItem(orig_chain_pointer->getItem());
+      head_ptr_ = createNode(orig_chain_pointer->getItem());
 
       // Copy remaining nodes
       Node<T>* new_chain_ptr = head_ptr_;      // Points to last node in new chain
@@ -44,7 +46,7 @@ LinkedList<T>::LinkedList(const LinkedList<T>& a_list) : item_count_(a_list.item
          T next_item = orig_chain_pointer->getItem();
 
          // Create a new node containing the next item
-         Node<T>* new_node_ptr = new Node<T>(next_item);
+         Node<T>* new_node_ptr = createNode(next_item);
 
          // Link new node to end of new chain
          new_chain_ptr->setNext(new_node_ptr);
@@ -57,13 +59,14 @@ LinkedList<T>::LinkedList(const LinkedList<T>& a_list) : item_count_(a_list.item
       }  // end while
 
       new_chain_ptr->setNext(nullptr);              // Flag end of chain
+      tail_ptr_ = new_chain_ptr;
    }  // end if
 }  // end copy constructor
 
 
 // destructor
-template<class T>
-LinkedList<T>::~LinkedList()
+template<class T, class Alloc>
+LinkedList<T, Alloc>::~LinkedList()
 {
    clear();
 }  // end destructor
@@ -71,16 +74,16 @@ LinkedList<T>::~LinkedList()
 
 
 /**@return true if list is empty - item_count_ == 0 */
-template<class T>
-bool LinkedList<T>::isEmpty() const
+template<class T, class Alloc>
+bool LinkedList<T, Alloc>::isEmpty() const
 {
    return item_count_ == 0;
 }  // end isEmpty
 
 
 /**@return the number of items in the list - item_count_ */
-template<class T>
-int LinkedList<T>::getLength() const
+template<class T, class Alloc>
+int LinkedList<T, Alloc>::getLength() const
 {
    return item_count_;
 }  // end getLength
@@ -93,14 +96,14 @@ int LinkedList<T>::getLength() const
  @param new_entry to be inserted in list
  @post new_entry is added at position in list (the node previously at that position is now at position+1)
  @return true if valid position (0 <= position <= item_count_) */
-template<class T>
-bool LinkedList<T>::insert(int positions, const T& new_entry)
+template<class T, class Alloc>
+bool LinkedList<T, Alloc>::insert(int positions, const T& new_entry)
 {
    bool able_to_insert = (positions >= 0) && (positions <= item_count_ );
    if (able_to_insert)
    {
       // Create a new node containing the new entry
-      Node<T>* new_node_ptr = new Node<T>(new_entry);
+      Node<T>* new_node_ptr = createNode(new_entry);
 
       // Attach new node to chain
       if (positions == 0)
@@ -111,12 +114,14 @@ bool LinkedList<T>::insert(int positions, const T& new_entry)
       }
       else
       {
-         // Find node that will be before new node
+         // Find node that will be before new node (getNodeAt is O(1) for the tail)
          Node<T>* prev_ptr = getNodeAt(positions - 1);
          // Insert new node after node to which prev_ptr points
          new_node_ptr->setNext(prev_ptr->getNext());
          prev_ptr->setNext(new_node_ptr);
       }  // end if
+      if (positions == item_count_)
+         tail_ptr_ = new_node_ptr;  // Appended, so the new node is the last one
       item_count_++;  // Increase count of entries
    }  // end if
 
@@ -130,38 +135,15 @@ bool LinkedList<T>::insert(int positions, const T& new_entry)
  @param position indicating point of deletion
  @post node at position is deleted, if any. List order is retains
  @return true if there is a node at position to be deleted, false otherwise */
-template<class T>
-bool LinkedList<T>::remove(int position)
+template<class T, class Alloc>
+bool LinkedList<T, Alloc>::remove(int position)
 {
    bool able_to_remove = (position >= 0) && (position < item_count_);
    if (able_to_remove)
    {
-      Node<T>* cur_ptr = nullptr;
-      if (position == 0)
-      {
-         // Remove the first node in the chain
-         cur_ptr = head_ptr_; // Save pointer to node
-         head_ptr_ = head_ptr_->getNext();
-      }
-      else
-      {
-         // Find node that is before the one to delete
-         Node<T>* prev_ptr = getNodeAt(position - 1);
-
-         // Point to node to delete
-         cur_ptr = prev_ptr->getNext();
-
-         // Disconnect indicated node from chain by connecting the
-         // prior node with the one after
-         prev_ptr->setNext(cur_ptr->getNext());
-      }  // end if
-
-      // Return node to system
-      cur_ptr->setNext(nullptr);
-      delete cur_ptr;
-      cur_ptr = nullptr;
-
-      item_count_--;  // Decrease count of entries
+      // Find node that is before the one to delete, if any
+      Node<T>* prev_ptr = (position == 0) ? nullptr : getNodeAt(position - 1);
+      removeAfter(prev_ptr);
    }  // end if
 
    return able_to_remove;
@@ -170,8 +152,8 @@ bool LinkedList<T>::remove(int position)
 
 
 /**@post the list is empty and item_count_ == 0*/
-template<class T>
-void LinkedList<T>::clear()
+template<class T, class Alloc>
+void LinkedList<T, Alloc>::clear()
 {
    while (!isEmpty())
       remove(0);
@@ -184,8 +166,8 @@ void LinkedList<T>::clear()
  @param position indicating the position of the data to be retrieved
  @return data item found at position. If position is not a valid position < item_count_
  throws  PrecondViolatedExcep */
-template<class T>
-T LinkedList<T>::getEntry(int position) const
+template<class T, class Alloc>
+T LinkedList<T, Alloc>::getEntry(int position) const
 {
     // Enforce precondition
     bool ableToGet = (position >= 0) && (position < item_count_);
@@ -214,9 +196,13 @@ T LinkedList<T>::getEntry(int position) const
 // @param position the index of the desired node
 //       0 <= position < item_count_
 // @return  A pointer to the node at the given position or nullptr if position is >= item_count_
-template<class T>
-Node<T>* LinkedList<T>::getNodeAt(int position) const
+template<class T, class Alloc>
+Node<T>* LinkedList<T, Alloc>::getNodeAt(int position) const
 {
+    // The last node is always at hand
+    if (position == item_count_ - 1)
+        return tail_ptr_;
+
     // Count from the beginning of the chain
     Node<T>* cur_ptr = head_ptr_;
     for (int skip = 0; skip < position; skip++)
@@ -225,10 +211,72 @@ Node<T>* LinkedList<T>::getNodeAt(int position) const
     return cur_ptr;
 }  // end getNodeAt
 
+// Removes the node that follows prev_ptr without walking the chain.
+// @param prev_ptr the node before the one to delete, or nullptr to delete the head
+// @post the node after prev_ptr is deleted, if any. List order is retained
+// @return true if there was a node to be deleted, false otherwise
+template<class T, class Alloc>
+bool LinkedList<T, Alloc>::removeAfter(Node<T>* prev_ptr)
+{
+   Node<T>* cur_ptr = (prev_ptr == nullptr) ? head_ptr_ : prev_ptr->getNext();
+   if (cur_ptr == nullptr)
+      return false;
+
+   // Disconnect the node by connecting its predecessor with the one after
+   if (prev_ptr == nullptr)
+      head_ptr_ = cur_ptr->getNext();
+   else
+      prev_ptr->setNext(cur_ptr->getNext());
+   if (cur_ptr == tail_ptr_)
+      tail_ptr_ = prev_ptr;  // Removed the last node
+
+   // Return node to the allocator
+   cur_ptr->setNext(nullptr);
+   destroyNode(cur_ptr);
+   cur_ptr = nullptr;
+
+   item_count_--;  // Decrease count of entries
+   return true;
+}  // end removeAfter
+
+// Relinks the node that follows prev_ptr at the front of the chain.
+// @param prev_ptr the node before the one to move, or nullptr if it is already the head
+// @post the node is the head and the rest of the list keeps its order; no node is allocated or freed
+template<class T, class Alloc>
+void LinkedList<T, Alloc>::moveToFront(Node<T>* prev_ptr)
+{
+   if (prev_ptr == nullptr || prev_ptr->getNext() == nullptr)
+      return;  // Already at the front, or nothing to move
+
+   Node<T>* cur_ptr = prev_ptr->getNext();
+   prev_ptr->setNext(cur_ptr->getNext());
+   if (cur_ptr == tail_ptr_)
+      tail_ptr_ = prev_ptr;
+   cur_ptr->setNext(head_ptr_);
+   head_ptr_ = cur_ptr;
+}  // end moveToFront
+
+// Makes a node holding item with the list's allocator
+template<class T, class Alloc>
+Node<T>* LinkedList<T, Alloc>::createNode(const T& item)
+{
+   Node<T>* node_ptr = std::allocator_traits<Alloc>::allocate(alloc_, 1);
+   std::allocator_traits<Alloc>::construct(alloc_, node_ptr, item);
+   return node_ptr;
+}  // end createNode
+
+// Destroys a node made by createNode and gives its memory back to the allocator
+template<class T, class Alloc>
+void LinkedList<T, Alloc>::destroyNode(Node<T>* node_ptr)
+{
+   std::allocator_traits<Alloc>::destroy(alloc_, node_ptr);
+   std::allocator_traits<Alloc>::deallocate(alloc_, node_ptr, 1);
+}  // end destroyNode
+
 //position follows classic indexing from 0 to item_count_-1
 //if position > item_count it returns nullptr
-template <class T>
-Node<T> *LinkedList<T>::getPointerTo(size_t position) const
+template<class T, class Alloc>
+Node<T> *LinkedList<T, Alloc>::getPointerTo(size_t position) const
 {
 
   Node<T> *find = nullptr;
@@ -248,12 +296,81 @@ Node<T> *LinkedList<T>::getPointerTo(size_t position) const
 
 
 //returns the head pointer
-template <class T>
-Node<T> *LinkedList<T>::getHeadNode() const
+template<class T, class Alloc>
+Node<T> *LinkedList<T, Alloc>::getHeadNode() const
 {
 
   return head_ptr_;
 } //end getHeadNode
 
 
+//returns an iterator to the first item
+template<class T, class Alloc>
+typename LinkedList<T, Alloc>::Iterator LinkedList<T, Alloc>::begin() const
+{
+  return Iterator(head_ptr_);
+} //end begin
+
+//returns an iterator past the last item
+template<class T, class Alloc>
+typename LinkedList<T, Alloc>::Iterator LinkedList<T, Alloc>::end() const
+{
+  return Iterator(nullptr);
+} //end end
+
+
+
+/************* ITERATOR METHODS ************/
+
+template<class T, class Alloc>
+LinkedList<T, Alloc>::Iterator::Iterator(Node<T>* node_ptr) : node_ptr_(node_ptr)
+{
+} //end Iterator constructor
+
+template<class T, class Alloc>
+typename LinkedList<T, Alloc>::Iterator::reference LinkedList<T, Alloc>::Iterator::operator*() const
+{
+  return node_ptr_->getItemReference();
+} //end operator*
+
+template<class T, class Alloc>
+typename LinkedList<T, Alloc>::Iterator::pointer LinkedList<T, Alloc>::Iterator::operator->() const
+{
+  return &node_ptr_->getItemReference();
+} //end operator->
+
+template<class T, class Alloc>
+typename LinkedList<T, Alloc>::Iterator& LinkedList<T, Alloc>::Iterator::operator++()
+{
+  node_ptr_ = node_ptr_->getNext();
+  return *this;
+} //end operator++
+
+template<class T, class Alloc>
+typename LinkedList<T, Alloc>::Iterator LinkedList<T, Alloc>::Iterator::operator++(int)
+{
+  Iterator before = *this;
+  node_ptr_ = node_ptr_->getNext();
+  return before;
+} //end operator++(int)
+
+template<class T, class Alloc>
+bool LinkedList<T, Alloc>::Iterator::operator==(const Iterator& rhs) const
+{
+  return node_ptr_ == rhs.node_ptr_;
+} //end operator==
+
+template<class T, class Alloc>
+bool LinkedList<T, Alloc>::Iterator::operator!=(const Iterator& rhs) const
+{
+  return node_ptr_ != rhs.node_ptr_;
+} //end operator!=
+
+template<class T, class Alloc>
+Node<T>* LinkedList<T, Alloc>::Iterator::getNode() const
+{
+  return node_ptr_;
+} //end getNode
+
+
 //  End of implementation file.
@@ -14,16 +14,54 @@
 #define LINKED_LIST_
 
 #include "Node.hpp"
+#include "NodePool.hpp"
 #include "PrecondViolatedExcep.hpp"
 #include <iostream>
+#include <cstddef>
+#include <iterator>
+#include <memory>
 
-template<class T>
+// Alloc allocates the Node<T> objects; the default pools them in slabs. Every list default-constructs
+// its own Alloc, so it needs value_type, allocate and deallocate but never has to be copied
+template<class T, class Alloc = NodePool<T>>
 class LinkedList
 {
 
 public:
+   /** Forward iterator over the items of the list, front to back.
+       Items are read-only; use insert and remove to change the list.
+       An iterator stays valid until the node it points to is removed. */
+   class Iterator
+   {
+   public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = T;
+      using difference_type = std::ptrdiff_t;
+      using pointer = const T*;
+      using reference = const T&;
+
+      Iterator(Node<T>* node_ptr = nullptr);
+
+      /**@return the item at the current node */
+      reference operator*() const;
+      pointer operator->() const;
+
+      /**@post the iterator points to the next node (end() after the last one) */
+      Iterator& operator++();
+      Iterator operator++(int);
+
+      bool operator==(const Iterator& rhs) const;
+      bool operator!=(const Iterator& rhs) const;
+
+      /**@return the current node, nullptr for end() */
+      Node<T>* getNode() const;
+
+   private:
+      Node<T>* node_ptr_;
+   }; // end Iterator
+
    LinkedList(); // constructor
-   LinkedList(const LinkedList<T>& a_list); // copy constructor
+   LinkedList(const LinkedList<T, Alloc>& a_list); // copy constructor, the copy gets its own allocator
    virtual ~LinkedList(); // destructor
 
    /**@return true if list is empty - item_count_ == 0 */
@@ -67,6 +105,12 @@ public:
 
     Node<T> *getHeadNode() const;
 
+   /**@return an iterator to the first item (equal to end() if the list is empty) */
+   Iterator begin() const;
+
+   /**@return an iterator past the last item */
+   Iterator end() const;
+
 
 
 
@@ -74,6 +118,7 @@ public:
 protected:
     Node<T>* head_ptr_; // Pointer to first node in the chain;
     // (contains the first entry in the list)
+    Node<T>* tail_ptr_; // Pointer to last node in the chain, so appending is O(1)
     int item_count_;           // Current count of list items
 
 
@@ -85,6 +130,23 @@ protected:
     // @return  A pointer to the node at the given position or nullptr if position is >= item_count_
     Node<T>* getNodeAt(int position) const;
 
+    // Removes the node that follows prev_ptr without walking the chain.
+    // @param prev_ptr the node before the one to delete, or nullptr to delete the head
+    // @post the node after prev_ptr is deleted, if any. List order is retained
+    // @return true if there was a node to be deleted, false otherwise
+    bool removeAfter(Node<T>* prev_ptr);
+
+    // Relinks the node that follows prev_ptr at the front of the chain.
+    // @param prev_ptr the node before the one to move, or nullptr if it is already the head
+    // @post the node is the head and the rest of the list keeps its order; no node is allocated or freed
+    void moveToFront(Node<T>* prev_ptr);
+
+private:
+    Alloc alloc_; // source of every node in the chain
+
+    Node<T>* createNode(const T& item);
+    void destroyNode(Node<T>* node_ptr);
+
 
 
 
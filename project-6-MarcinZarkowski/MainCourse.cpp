@@ -1,4 +1,6 @@
 #include "MainCourse.hpp"
+#include "DietaryRules.hpp"
+#include <algorithm>
 
 /**
  * Default constructor.
@@ -94,7 +96,7 @@ side dishes, and gluten-free status.
 
 void MainCourse::display() const
 {
-    std::cout << "Dish Name: " << getName() << std::endl;
+    std::cout << "Dish Name: " << getName() << '\n';
     std::cout << "Ingredients: ";
     for (size_t i = 0; i < getIngredients().size(); ++i) {
         std::cout << getIngredients()[i].name;
@@ -102,13 +104,13 @@ void MainCourse::display() const
             std::cout << ", ";
         }
     }
-    std::cout << std::endl;
-    std::cout << "Preparation Time: " << getPrepTime() << " minutes" << std::endl;
-    std::cout << std::fixed << std::setprecision(2) << "Price: $" << getPrice() << std::endl;
-    std::cout << "Cuisine Type: " << getCuisineType() << std::endl;
+    std::cout << '\n';
+    std::cout << "Preparation Time: " << getPrepTime() << " minutes" << '\n';
+    std::cout << std::fixed << std::setprecision(2) << "Price: $" << getPrice() << '\n';
+    std::cout << "Cuisine Type: " << getCuisineType() << '\n';
 
-    std::cout << "Cooking Method: " << cookingMethodToString(cooking_method_) << std::endl;
-    std::cout << "Protein Type: " << protein_type_ << std::endl;
+    std::cout << "Cooking Method: " << cookingMethodToString(cooking_method_) << '\n';
+    std::cout << "Protein Type: " << protein_type_ << '\n';
     std::cout << "Side Dishes: ";
     for (size_t i = 0; i < side_dishes_.size(); ++i) {
         std::cout << side_dishes_[i].name << " (Category: " << categoryToString(side_dishes_[i].category) << ")";
@@ -116,8 +118,8 @@ void MainCourse::display() const
             std::cout << ", ";
         }
     }
-    std::cout << std::endl;
-    std::cout << "Gluten-Free: " << (gluten_free_ ? "Yes" : "No") << std::endl;
+    std::cout << '\n';
+    std::cout << "Gluten-Free: " << (gluten_free_ ? "Yes" : "No") << '\n';
 }
 
 /**
@@ -148,81 +150,23 @@ void MainCourse::display() const
     */
 void MainCourse::dietaryAccommodations(const DietaryRequest &request)
 {
-    if (request.vegetarian)
+    if (request.vegetarian || request.vegan)
     {
         protein_type_ = "Tofu";
-        bool first_replacement_done = false;
-        bool second_replacement_done = false;
-
-        // Create a local mutable copy of ingredients
-        std::vector<Ingredient> ingredients = getIngredients();
-
-        for (size_t i = 0; i < ingredients.size(); ++i)
-        {
-            if (ingredients[i].name == "Meat" || ingredients[i].name == "Chicken" || ingredients[i].name == "Fish" || 
-                ingredients[i].name == "Beef" || ingredients[i].name == "Pork" || ingredients[i].name == "Lamb" || 
-                ingredients[i].name == "Shrimp" || ingredients[i].name == "Bacon")
-            {
-                if (!first_replacement_done)
-                {
-                    ingredients[i].name = "Beans";  // First replacement
-                    first_replacement_done = true;
-                }
-                else if (!second_replacement_done)
-                {
-                    ingredients[i].name = "Mushrooms";  // Second replacement
-                    second_replacement_done = true;
-                }
-                else
-                {
-                    ingredients.erase(ingredients.begin() + i);  // Remove non-vegetarian item
-                    i--;  // Adjust index after erase
-                }
-            }
-        }
-        // Update ingredients
-        setIngredients(ingredients);
-        
     }
-    if (request.vegan)
-    {
-        protein_type_ = "Tofu";
 
-        // Create a local mutable copy of ingredients
-        std::vector<Ingredient> ingredients = getIngredients();
+    // one pass over the ingredients: the first two non-vegetarian ones become "Beans" and "Mushrooms"
+    // and the rest are removed, and dairy and egg are removed for vegan
+    applyIngredientRules(request.vegetarian ? DietaryRules::MEAT : 0,
+                         request.vegan ? DietaryRules::DAIRY_OR_EGG : 0);
 
-        if (!ingredients.empty())
-        {
-            for (size_t i = 0; i < ingredients.size(); ++i)
-            {
-                if (ingredients[i].name == "Milk" || ingredients[i].name == "Eggs" || ingredients[i].name == "Cheese" || 
-                    ingredients[i].name == "Butter" || ingredients[i].name == "Cream" || ingredients[i].name == "Yogurt")
-                {
-                    ingredients.erase(ingredients.begin() + i);  // Remove non-vegan item
-                    i--;  // Adjust index after erase
-                }
-            }
-        }
-        // Update ingredients
-        setIngredients(ingredients);
-    }
     if (request.gluten_free)
     {
         gluten_free_ = true;
-        if (side_dishes_.size() > 0)
-        {
-            for (size_t i = 0; i < side_dishes_.size(); ++i)
-            {
-                if (categoryToString(side_dishes_[i].category) == "GRAIN" || categoryToString(side_dishes_[i].category) == "PASTA" || categoryToString(side_dishes_[i].category) == "BREAD" || categoryToString(side_dishes_[i].category) == "STARCHES")
-                {
-                    side_dishes_.erase(side_dishes_.begin() + i);
-                    i--;
-                }
-            }
-        }
+        side_dishes_.erase(std::remove_if(side_dishes_.begin(), side_dishes_.end(),
+                                          [](const SideDish& side) { return containsGluten(side.category); }),
+                           side_dishes_.end());
     }
-    
-    
 }
 //enum Category { GRAIN, PASTA, LEGUME, BREAD, SALAD, SOUP, STARCHES, VEGETABLE };
 std::string MainCourse::categoryToString(const Category &category) const {
@@ -245,6 +189,11 @@ std::string MainCourse::categoryToString(const Category &category) const {
             return "VEGETABLE";
     }
 }
+bool MainCourse::containsGluten(Category category) {
+    static const unsigned GLUTEN_CATEGORIES = (1u << GRAIN) | (1u << PASTA) | (1u << BREAD) | (1u << STARCHES);
+    return (GLUTEN_CATEGORIES >> category) & 1u;
+}
+
 
 //enum CookingMethod { GRILLED, BAKED, BOILED, FRIED, STEAMED, RAW };
 std::string MainCourse::cookingMethodToString(const CookingMethod &cooking_method) const {
@@ -141,6 +141,8 @@ private:
     std::string cookingMethodToString(const CookingMethod &cooking_method) const;
     // Helper function to convert category to string
     std::string categoryToString(const Category &category) const;
+    // true for the side dish categories a gluten-free request removes: GRAIN, PASTA, BREAD, STARCHES
+    static bool containsGluten(Category category);
     CookingMethod cooking_method_; ///< The cooking method used for the main course.
     std::string protein_type_; ///< The type of protein used in the main course.
     std::vector<SideDish> side_dishes_; ///< The side dishes served with the main course.
@@ -0,0 +1,222 @@
+/** Bounded lock-free multi-producer/multi-consumer queue.
+ Implementation file for the class MpmcQueue.
+ @file MpmcQueue.cpp */
+
+#include "MpmcQueue.hpp"  // Header file
+
+// constructor
+template<class T>
+MpmcQueue<T>::MpmcQueue(size_t capacity) : enqueue_pos_(0), dequeue_pos_(0)
+{
+   size_t size = 2;
+   while (size < capacity)
+      size *= 2;
+
+   buffer_.reset(new Cell[size]);
+   mask_ = size - 1;
+   for (size_t i = 0; i < size; i++)
+      buffer_[i].sequence_.store(i, std::memory_order_relaxed);
+}  // end constructor
+
+
+/**@return the most items the queue can hold */
+template<class T>
+size_t MpmcQueue<T>::capacity() const
+{
+   return mask_ + 1;
+}  // end capacity
+
+
+/**@return true if the queue looked empty at the moment of the call */
+template<class T>
+bool MpmcQueue<T>::isEmpty() const
+{
+   return dequeue_pos_.load(std::memory_order_acquire) >= enqueue_pos_.load(std::memory_order_acquire);
+}  // end isEmpty
+
+
+/**
+ @param new_entry to be added at the back of the queue
+ @return true if the entry was added, false if the queue was full */
+template<class T>
+bool MpmcQueue<T>::tryPush(const T& new_entry)
+{
+   size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+   while (true)
+   {
+      Cell& cell = buffer_[pos & mask_];
+      size_t seq = cell.sequence_.load(std::memory_order_acquire);
+      ptrdiff_t diff = static_cast<ptrdiff_t>(seq) - static_cast<ptrdiff_t>(pos);
+      if (diff == 0)
+      {
+         // the cell is free for this lap, try to claim the position
+         if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+         {
+            cell.item_ = new_entry;
+            cell.sequence_.store(pos + 1, std::memory_order_release); // publish to consumers
+            return true;
+         }
+      }
+      else if (diff < 0)
+      {
+         return false; // the cell still holds an item from the previous lap: full
+      }
+      else
+      {
+         pos = enqueue_pos_.load(std::memory_order_relaxed); // another producer got here first
+      }
+   }  // end while
+}  // end tryPush
+
+
+/**
+ @param entries the items to add, in order
+ @param count the number of items in entries
+ @return the number of items added */
+template<class T>
+size_t MpmcQueue<T>::tryPushBatch(const T* entries, size_t count)
+{
+   size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+   size_t claimed = 0;
+   while (true)
+   {
+      // count how many consecutive cells from pos are free for this lap
+      claimed = 0;
+      while (claimed < count && claimed <= mask_)
+      {
+         size_t seq = buffer_[(pos + claimed) & mask_].sequence_.load(std::memory_order_acquire);
+         if (seq != pos + claimed)
+            break;
+         claimed++;
+      }  // end while
+
+      if (claimed == 0)
+      {
+         if (count == 0)
+            return 0;
+         size_t seq = buffer_[pos & mask_].sequence_.load(std::memory_order_acquire);
+         if (static_cast<ptrdiff_t>(seq) - static_cast<ptrdiff_t>(pos) < 0)
+            return 0; // full
+         pos = enqueue_pos_.load(std::memory_order_relaxed); // another producer got here first
+         continue;
+      }
+
+      // claim the whole run at once; on failure pos is reloaded and the run is counted again
+      if (enqueue_pos_.compare_exchange_weak(pos, pos + claimed, std::memory_order_relaxed))
+         break;
+   }  // end while
+
+   for (size_t i = 0; i < claimed; i++)
+   {
+      Cell& cell = buffer_[(pos + i) & mask_];
+      cell.item_ = entries[i];
+      cell.sequence_.store(pos + i + 1, std::memory_order_release); // publish to consumers
+   }  // end for
+
+   return claimed;
+}  // end tryPushBatch
+
+
+/**
+ @param entry receives the item at the front of the queue, if any
+ @return true if an item was removed, false if the queue was empty */
+template<class T>
+bool MpmcQueue<T>::tryPop(T& entry)
+{
+   size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+   while (true)
+   {
+      Cell& cell = buffer_[pos & mask_];
+      size_t seq = cell.sequence_.load(std::memory_order_acquire);
+      ptrdiff_t diff = static_cast<ptrdiff_t>(seq) - static_cast<ptrdiff_t>(pos + 1);
+      if (diff == 0)
+      {
+         // the cell holds this position's item, try to claim it
+         if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+         {
+            entry = cell.item_;
+            cell.sequence_.store(pos + mask_ + 1, std::memory_order_release); // free for the next lap
+            return true;
+         }
+      }
+      else if (diff < 0)
+      {
+         return false; // nothing published at this position yet: empty
+      }
+      else
+      {
+         pos = dequeue_pos_.load(std::memory_order_relaxed); // another consumer got here first
+      }
+   }  // end while
+}  // end tryPop
+
+
+/**
+ @param out the removed items are appended to out, in queue order
+ @param max_count the most items to remove
+ @return the number of items removed */
+template<class T>
+size_t MpmcQueue<T>::tryPopBatch(std::vector<T>& out, size_t max_count)
+{
+   if (max_count == 0)
+      return 0;
+
+   size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+   size_t count = 0;
+   while (true)
+   {
+      // count how many consecutive cells from pos are already published
+      count = 0;
+      while (count < max_count && count <= mask_)
+      {
+         size_t seq = buffer_[(pos + count) & mask_].sequence_.load(std::memory_order_acquire);
+         if (seq != pos + count + 1)
+            break;
+         count++;
+      }  // end while
+
+      if (count == 0)
+      {
+         size_t seq = buffer_[pos & mask_].sequence_.load(std::memory_order_acquire);
+         if (static_cast<ptrdiff_t>(seq) - static_cast<ptrdiff_t>(pos + 1) < 0)
+            return 0; // empty
+         pos = dequeue_pos_.load(std::memory_order_relaxed); // another consumer got here first
+         continue;
+      }
+
+      // claim the whole run at once; on failure pos is reloaded and the run is counted again
+      if (dequeue_pos_.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed))
+         break;
+   }  // end while
+
+   for (size_t i = 0; i < count; i++)
+   {
+      Cell& cell = buffer_[(pos + i) & mask_];
+      out.push_back(cell.item_);
+      cell.sequence_.store(pos + i + mask_ + 1, std::memory_order_release);
+   }  // end for
+
+   return count;
+}  // end tryPopBatch
+
+
+/**
+ @pre no other thread is popping while the snapshot is taken (concurrent pushes are fine;
+      items published after the snapshot starts may be missed)
+ @param visit called with a const reference to each item */
+template<class T>
+template<class Visitor>
+void MpmcQueue<T>::forEach(Visitor visit) const
+{
+   size_t end = enqueue_pos_.load(std::memory_order_acquire);
+   for (size_t pos = dequeue_pos_.load(std::memory_order_acquire); pos < end; pos++)
+   {
+      const Cell& cell = buffer_[pos & mask_];
+      if (cell.sequence_.load(std::memory_order_acquire) != pos + 1)
+         break; // claimed but not yet published
+      visit(cell.item_);
+   }  // end for
+}  // end forEach
+
+
+//  End of implementation file.
@@ -0,0 +1,88 @@
+/** Bounded lock-free multi-producer/multi-consumer queue.
+    A ring buffer of cells, each stamped with a sequence number that tells producers
+    and consumers whether the cell is free or holds an item for the current lap
+    (D. Vyukov's bounded MPMC queue).
+    @file MpmcQueue.hpp */
+
+#ifndef MPMC_QUEUE_
+#define MPMC_QUEUE_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+template<class T>
+class MpmcQueue
+{
+
+public:
+   /**
+    @param capacity the most items the queue can hold, rounded up to a power of two (at least 2)
+    @post the queue is empty */
+   explicit MpmcQueue(size_t capacity);
+
+   MpmcQueue(const MpmcQueue<T>&) = delete;
+   MpmcQueue<T>& operator=(const MpmcQueue<T>&) = delete;
+
+   /**@return the most items the queue can hold */
+   size_t capacity() const;
+
+   /**@return true if the queue looked empty at the moment of the call */
+   bool isEmpty() const;
+
+   /**
+    Safe to call from any number of threads at once.
+    @param new_entry to be added at the back of the queue
+    @return true if the entry was added, false if the queue was full */
+   bool tryPush(const T& new_entry);
+
+   /**
+    Adds up to count items at the back of the queue with a single claim.
+    Safe to call from any number of threads at once.
+    @param entries the items to add, in order
+    @param count the number of items in entries
+    @return the number of items added from the front of entries (fewer than count once the queue is full) */
+   size_t tryPushBatch(const T* entries, size_t count);
+
+   /**
+    Safe to call from any number of threads at once.
+    @param entry receives the item at the front of the queue, if any
+    @return true if an item was removed, false if the queue was empty */
+   bool tryPop(T& entry);
+
+   /**
+    Removes up to max_count items from the front of the queue with a single claim,
+    so a consumer pays one compare-and-swap per batch instead of one per item.
+    Safe to call from any number of threads at once.
+    @param out the removed items are appended to out, in queue order
+    @param max_count the most items to remove
+    @return the number of items removed */
+   size_t tryPopBatch(std::vector<T>& out, size_t max_count);
+
+   /**
+    Visits the items currently in the queue, front to back, without copying or removing them.
+    @pre no other thread is popping while the snapshot is taken (concurrent pushes are fine;
+         items published after the snapshot starts may be missed)
+    @param visit called with a const reference to each item */
+   template<class Visitor>
+   void forEach(Visitor visit) const;
+
+private:
+   struct Cell
+   {
+      std::atomic<size_t> sequence_; // == position when free, position + 1 when it holds that position's item
+      T item_;
+   };
+
+   std::unique_ptr<Cell[]> buffer_;
+   size_t mask_; // capacity - 1, positions are mapped to cells with position & mask_
+
+   // producers and consumers each advance their own counter, kept on separate cache lines
+   alignas(64) std::atomic<size_t> enqueue_pos_;
+   alignas(64) std::atomic<size_t> dequeue_pos_;
+
+}; // end MpmcQueue
+
+#include "MpmcQueue.cpp"
+#endif
@@ -54,6 +54,13 @@ T Node<T>::getItem() const
    return item_;
 } // end getItem
 
+/**@return a reference to item_, so it can be read without a copy */
+template<class T>
+const T& Node<T>::getItemReference() const
+{
+   return item_;
+} // end getItemReference
+
  /**@return next_*/
 template<class T>
 Node<T>* Node<T>::getNext() const
@@ -26,6 +26,9 @@ public:
     
     /**@return item_*/
    T getItem() const ;
+
+    /**@return a reference to item_, so it can be read without a copy */
+   const T& getItemReference() const ;
     
     /**@return next_*/
    Node<T>* getNext() const ;
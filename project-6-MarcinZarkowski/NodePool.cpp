@@ -0,0 +1,87 @@
+/** Slab allocator for list nodes.
+ Implementation file for the class NodePool.
+ @file NodePool.cpp */
+
+#include "NodePool.hpp"  // Header file
+#include <new>
+
+// constructor
+template<class T>
+NodePool<T>::NodePool() : free_list_(nullptr), slab_used_(SLAB_SIZE)
+{
+}  // end default constructor
+
+
+// destructor
+template<class T>
+NodePool<T>::~NodePool()
+{
+   // slabs_ frees every slab; the nodes in them must already be destroyed
+}  // end destructor
+
+
+/**
+ @param count number of nodes wanted; single nodes come from the pool, larger requests from the system
+ @return uninitialized storage for count nodes */
+template<class T>
+Node<T>* NodePool<T>::allocate(std::size_t count)
+{
+   if (count != 1)
+      return static_cast<Node<T>*>(::operator new(count * sizeof(Node<T>)));
+
+   Slot* slot = nullptr;
+   if (free_list_ != nullptr)
+   {
+      // Reuse the most recently freed node, it is the most likely to still be in cache
+      slot = free_list_;
+      free_list_ = free_list_->next_free_;
+   }
+   else
+   {
+      if (slab_used_ == SLAB_SIZE)
+      {
+         // Newest slab is used up, start another
+         slabs_.push_back(std::unique_ptr<Slot[]>(new Slot[SLAB_SIZE]));
+         slab_used_ = 0;
+      }  // end if
+      slot = &slabs_.back()[slab_used_];
+      slab_used_++;
+   }  // end if
+
+   return reinterpret_cast<Node<T>*>(slot->storage_);
+}  // end allocate
+
+
+/**
+ @param node_ptr storage returned by allocate(count) on this pool, whose node was already destroyed
+ @param count the count passed to allocate
+ @post a single node goes back on the free list */
+template<class T>
+void NodePool<T>::deallocate(Node<T>* node_ptr, std::size_t count)
+{
+   if (count != 1)
+   {
+      ::operator delete(node_ptr);
+      return;
+   }  // end if
+
+   Slot* slot = reinterpret_cast<Slot*>(node_ptr);
+   slot->next_free_ = free_list_;
+   free_list_ = slot;
+}  // end deallocate
+
+
+template<class T>
+bool NodePool<T>::operator==(const NodePool<T>& rhs) const
+{
+   return this == &rhs;
+}  // end operator==
+
+template<class T>
+bool NodePool<T>::operator!=(const NodePool<T>& rhs) const
+{
+   return this != &rhs;
+}  // end operator!=
+
+
+//  End of implementation file.
@@ -0,0 +1,63 @@
+/** Slab allocator for list nodes.
+    Nodes are carved out of fixed-size slabs and freed nodes go on a free list,
+    so inserting and removing list items reuses memory instead of calling new and delete.
+    Not a standard allocator: a pool can't be copied or rebound to another type. It only
+    has the members std::allocator_traits needs for LinkedList to allocate its nodes, and
+    each list default-constructs its own pool (a copied list gets a fresh one).
+    @file NodePool.hpp */
+
+#ifndef NODE_POOL_
+#define NODE_POOL_
+
+#include "Node.hpp"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+template<class T>
+class NodePool
+{
+
+public:
+   using value_type = Node<T>;
+
+   NodePool(); // constructor
+   ~NodePool(); // destructor, returns the slabs to the system
+
+   // every pool owns its own slabs, so pools are never copied
+   NodePool(const NodePool<T>&) = delete;
+   NodePool<T>& operator=(const NodePool<T>&) = delete;
+
+   /**
+    @param count number of nodes wanted; single nodes come from the pool, larger requests from the system
+    @return uninitialized storage for count nodes */
+   Node<T>* allocate(std::size_t count);
+
+   /**
+    @param node_ptr storage returned by allocate(count) on this pool, whose node was already destroyed
+    @param count the count passed to allocate
+    @post a single node goes back on the free list */
+   void deallocate(Node<T>* node_ptr, std::size_t count);
+
+   /**@return true if both are the same pool (only a pool can take back its own nodes) */
+   bool operator==(const NodePool<T>& rhs) const;
+   bool operator!=(const NodePool<T>& rhs) const;
+
+private:
+   // a free slot holds the link to the next free slot; a used slot holds a node
+   union Slot
+   {
+      Slot* next_free_;
+      alignas(Node<T>) unsigned char storage_[sizeof(Node<T>)];
+   };
+
+   static const std::size_t SLAB_SIZE = 64; // nodes per slab
+
+   std::vector<std::unique_ptr<Slot[]>> slabs_;
+   Slot* free_list_;       // most recently freed slot, nullptr if none
+   std::size_t slab_used_; // slots handed out from the newest slab
+
+}; // end NodePool
+
+#include "NodePool.cpp"
+#endif
@@ -0,0 +1,4 @@
+#include "NullEventSink.hpp"
+
+void NullEventSink::emit(const Event&) {
+}
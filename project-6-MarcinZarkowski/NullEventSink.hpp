@@ -0,0 +1,13 @@
+// Event sink that drops every event, for running the kitchen without any output.
+
+#ifndef NULLEVENTSINK_HPP
+#define NULLEVENTSINK_HPP
+
+#include "KitchenEventSink.hpp"
+
+class NullEventSink : public KitchenEventSink {
+public:
+    void emit(const Event& event) override;
+};
+
+#endif // NULLEVENTSINK_HPP
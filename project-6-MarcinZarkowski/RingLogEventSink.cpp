@@ -0,0 +1,37 @@
+#include "RingLogEventSink.hpp"
+#include <algorithm>
+
+RingLogEventSink::RingLogEventSink(size_t capacity)
+    : ring_(capacity), emitted_(0) {
+}
+
+void RingLogEventSink::emit(const Event& event) {
+    ring_[emitted_ % ring_.size()] = event;
+    emitted_++;
+}
+
+size_t RingLogEventSink::size() const {
+    return emitted_ < ring_.size() ? static_cast<size_t>(emitted_) : ring_.size();
+}
+
+uint64_t RingLogEventSink::emitted() const {
+    return emitted_;
+}
+
+const KitchenEventSink::Event& RingLogEventSink::at(size_t i) const {
+    uint64_t oldest = emitted_ - size();
+    return ring_[(oldest + i) % ring_.size()];
+}
+
+void RingLogEventSink::writeTo(std::ostream& out) const {
+    // at most two contiguous runs: from the oldest record to the end of the ring, then from the start
+    size_t count = size();
+    size_t first = static_cast<size_t>((emitted_ - count) % ring_.size());
+    size_t head = std::min(count, ring_.size() - first);
+    out.write(reinterpret_cast<const char*>(&ring_[first]), static_cast<std::streamsize>(head * sizeof(Event)));
+    out.write(reinterpret_cast<const char*>(&ring_[0]), static_cast<std::streamsize>((count - head) * sizeof(Event)));
+}
+
+void RingLogEventSink::clear() {
+    emitted_ = 0;
+}
@@ -0,0 +1,61 @@
+// Event sink that keeps the most recent events in a fixed-size ring of binary records. Emitting is a
+// single store with no formatting or allocation; once the ring is full the oldest event is overwritten.
+// The records can be read back in order or dumped as raw bytes for offline decoding.
+
+#ifndef RINGLOGEVENTSINK_HPP
+#define RINGLOGEVENTSINK_HPP
+
+#include "KitchenEventSink.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+class RingLogEventSink : public KitchenEventSink {
+public:
+    /**
+     * @param capacity The number of events kept.
+     * @pre: capacity > 0.
+     */
+    explicit RingLogEventSink(size_t capacity);
+
+    /**
+     * @param event The event to record.
+     * @post: The event is the newest record; if the ring was full, the oldest record is gone.
+     */
+    void emit(const Event& event) override;
+
+    /**
+     * @return: The number of events kept, at most the capacity.
+     */
+    size_t size() const;
+
+    /**
+     * @return: The number of events emitted since the sink was made or cleared, including overwritten ones.
+     */
+    uint64_t emitted() const;
+
+    /**
+     * @param i The position of a kept event, 0 being the oldest.
+     * @pre: i < size().
+     * @return: The event at that position.
+     */
+    const Event& at(size_t i) const;
+
+    /**
+     * @param out A binary stream.
+     * @post: The kept events are written to out as raw Event records, oldest first.
+     */
+    void writeTo(std::ostream& out) const;
+
+    /**
+     * @post: No events are kept.
+     */
+    void clear();
+
+private:
+    std::vector<Event> ring_;
+    uint64_t emitted_;
+};
+
+#endif // RINGLOGEVENTSINK_HPP
@@ -5,100 +5,121 @@
 
 
 #include "StationManager.hpp"
+#include "StationWorker.hpp"
 #include <iostream>
 #include <map>
+#include <memory>
+#include <functional>
+#include <condition_variable>
 // Default Constructor
-StationManager::StationManager() {
+StationManager::StationManager() : console_sink_(std::cout), sink_(&console_sink_) {
     // Initializes an empty station manager
 }
 
 
 // Adds a new station to the station manager
 bool StationManager::addStation(KitchenStation* station) {
-    return insert(item_count_, station);
+    if (station == nullptr || station_index_.count(station->getName()) > 0) {
+        return false;
+    }
+    // the current last node becomes the predecessor of the new station
+    Node<KitchenStation*>* prev = tail_ptr_;
+    if (!insert(item_count_, station)) {
+        return false;
+    }
+    station_index_[station->getName()] = prev;
+    if (registry_) {
+        registry_->add(station);
+    }
+    return true;
 }
 
 // Removes a station from the station manager by name
 bool StationManager::removeStation(const std::string& station_name) {
-    for (int i = 0; i < item_count_; ++i) {
-        if (getEntry(i)->getName() == station_name) {
-            return remove(i);
-        }
+    auto it = station_index_.find(station_name);
+    if (it == station_index_.end()) {
+        return false;
     }
-    return false;
+    Node<KitchenStation*>* prev = it->second;
+    Node<KitchenStation*>* next = nodeAfter(prev)->getNext();
+
+    // the station after the removed one now follows the removed station's predecessor
+    if (next != nullptr) {
+        station_index_[next->getItem()->getName()] = prev;
+    }
+    station_index_.erase(it);
+    if (registry_) {
+        registry_->remove(nodeAfter(prev)->getItem());
+    }
+    return removeAfter(prev);
 }
 
 // Finds a station in the station manager by name
 KitchenStation* StationManager::findStation(const std::string& station_name) const {
-    Node<KitchenStation*>* searchptr = getHeadNode();
-    while (searchptr != nullptr) {
-        if (searchptr->getItem()->getName() == station_name) {
-            return searchptr->getItem();
-        }
-        searchptr = searchptr->getNext();
+    auto it = station_index_.find(station_name);
+    if (it == station_index_.end()) {
+        return nullptr;
     }
-    return nullptr;
+    return nodeAfter(it->second)->getItem();
 }
 
 // Moves a specified station to the front of the station manager list
 bool StationManager::moveStationToFront(const std::string& station_name) {
-    // First, make sure the station exists
-    if (findStation(station_name) == nullptr) {
+    auto it = station_index_.find(station_name);
+    if (it == station_index_.end()) {
         return false;
     }
-    
+
     // If it's already at the front, return true
-    if (getHeadNode()->getItem()->getName() == station_name) {
+    Node<KitchenStation*>* prev = it->second;
+    if (prev == nullptr) {
         return true;
     }
 
-    Node<KitchenStation*>* searchptr = getHeadNode();
-    while (searchptr != nullptr) {
-        if (searchptr->getItem()->getName() == station_name) {
-            // Make a copy of the station
-            KitchenStation* station = searchptr->getItem();
-            
-            // Remove the station from its current position
-            int pos = getStationIndex(searchptr->getItem()->getName());
-            remove(pos);
-            
-            // Insert the station at the front
-            insert(0, station);
-            
-            return true;  // Exit after moving the station
-        }
-        
-        searchptr = searchptr->getNext();  // Move to the next node
+    Node<KitchenStation*>* next = prev->getNext()->getNext();
+    if (next != nullptr) {
+        station_index_[next->getItem()->getName()] = prev;
     }
-    
-    return false;
+
+    // Relink the station's node at the front; the old front now follows it
+    KitchenStation* old_front = getHeadNode()->getItem();
+    if (registry_) {
+        registry_->moveToFront(prev->getNext()->getItem());
+    }
+    moveToFront(prev);
+
+    station_index_[station_name] = nullptr;
+    station_index_[old_front->getName()] = getHeadNode();
+    return true;
 }
 
 
-int StationManager::getStationIndex(const std::string& name) const {
-    Node<KitchenStation*>* searchptr = getHeadNode();
-    int index = 0;
-    while (searchptr != nullptr) {
-        if (searchptr->getItem()->getName() == name) {
-            return index;
-        }
-        searchptr = searchptr->getNext();
-        index++;
+// Mirrors the station list in a contiguous registry
+void StationManager::enableStationRegistry() {
+    if (registry_) {
+        return;
+    }
+    registry_.reset(new StationRegistry());
+    for (KitchenStation* station : *this) {
+        registry_->add(station);
     }
-    return -1;
+}
+
+Node<KitchenStation*>* StationManager::nodeAfter(Node<KitchenStation*>* prev) const {
+    return (prev == nullptr) ? getHeadNode() : prev->getNext();
 }
 
 // Merges the dishes and ingredients of two specified stations
 bool StationManager::mergeStations(const std::string& station_name1, const std::string& station_name2) {
     KitchenStation* station1 = findStation(station_name1);
     KitchenStation* station2 = findStation(station_name2);
-    if (station1 && station2) {
+    if (station1 && station2 && station1 != station2) {
         // take all the dishes from station2 and add them to station1
         for (Dish* dish : station2->getDishes()) {
             station1->assignDishToStation(dish);
         }
         // take all the ingredients from station2 and add them to station1
-        for (Ingredient ingredient : station2->getIngredientsStock()) {
+        for (const Ingredient& ingredient : station2->getIngredientsStock()) {
             station1->replenishStationIngredients(ingredient);
         }
         // remove station2 from the list
@@ -129,12 +150,15 @@ bool StationManager::replenishIngredientAtStation(const std::string& station_nam
 
 // Checks if any station in the station manager can complete an order for a specific dish
 bool StationManager::canCompleteOrder(const std::string& dish_name) const {
-    Node<KitchenStation*>* searchptr = getHeadNode();
-    while (searchptr != nullptr) {
-        if (searchptr->getItem()->canCompleteOrder(dish_name)) {
+    int dish_id = SymbolTable::dishes().lookup(dish_name);
+    if (registry_) {
+        // the recipe is checked against every station's stock at once
+        return !registry_->ableToComplete(dish_id).empty();
+    }
+    for (KitchenStation* station : *this) {
+        if (station->canCompleteOrder(dish_id)) {
             return true;
         }
-        searchptr = searchptr->getNext();
     }
     return false;
 }
@@ -154,7 +178,15 @@ bool StationManager::prepareDishAtStation(const std::string& station_name, const
 * @post: The dish preparation queue is returned unchanged.
 */
 std::queue<Dish*> StationManager::getDishQueue() const{
-    return dishqueue;
+    std::queue<Dish*> dish_queue(dishqueue);
+    if (intake_) {
+        intake_->forEach([&dish_queue](Dish* dish) { dish_queue.push(dish); });
+        std::lock_guard<std::mutex> lock(overflow_mutex_);
+        for (Dish* dish : overflow_) {
+            dish_queue.push(dish);
+        }
+    }
+    return dish_queue;
 }
 
 /**
@@ -164,7 +196,15 @@ supplies.
 * @post: The list of backup ingredients is returned unchanged.
 */
 std::vector<Ingredient> StationManager::getBackupIngredients() const{
-    return backupingredients;
+    return backupingredients.snapshot();
+}
+
+/**
+* Visits the backup ingredients in list order without copying them.
+* @param visit Called with each backup ingredient.
+*/
+void StationManager::forEachBackupIngredient(const std::function<void(const Ingredient&)>& visit) const{
+    backupingredients.forEach(visit);
 }
 
 /**
@@ -176,7 +216,12 @@ Dish objects.
 queue.
 */
 void StationManager::setDishQueue(std::queue<Dish*> dish_queue){
-    dishqueue = dish_queue;
+    drainIntake(); // dishes still waiting in the intake are part of the queue being replaced
+    dishqueue.clear();
+    while (!dish_queue.empty()) {
+        dishqueue.push_back(dish_queue.front());
+        dish_queue.pop();
+    }
 }
 
 /**
@@ -186,7 +231,44 @@ void StationManager::setDishQueue(std::queue<Dish*> dish_queue){
 * @post: The dish is added to the end of the queue.
 */
 void StationManager::addDishToQueue(Dish* dish){
-    dishqueue.push(dish);
+    if (!intake_) {
+        dishqueue.push_back(dish);
+        return;
+    }
+    if (!overflowing_.load(std::memory_order_acquire) && intake_->tryPush(dish)) {
+        return;
+    }
+    // the intake is full (or already spilling): keep order by queueing behind the earlier overflow
+    std::lock_guard<std::mutex> lock(overflow_mutex_);
+    overflow_.push_back(dish);
+    overflowing_.store(true, std::memory_order_release);
+}
+
+/**
+* Adds a burst of dishes to the preparation queue without dietary accommodations.
+* @param dishes Pointers to dynamically allocated Dish objects, in order.
+* @post: The dishes are added to the end of the queue in order.
+*/
+void StationManager::addDishesToQueue(const std::vector<Dish*>& dishes){
+    if (!intake_) {
+        dishqueue.insert(dishqueue.end(), dishes.begin(), dishes.end());
+        return;
+    }
+    size_t pushed = 0;
+    while (pushed < dishes.size() && !overflowing_.load(std::memory_order_acquire)) {
+        size_t claimed = intake_->tryPushBatch(dishes.data() + pushed, dishes.size() - pushed);
+        if (claimed == 0) {
+            break; // full
+        }
+        pushed += claimed;
+    }
+    if (pushed == dishes.size()) {
+        return;
+    }
+    // the rest queue behind the earlier overflow, as in addDishToQueue
+    std::lock_guard<std::mutex> lock(overflow_mutex_);
+    overflow_.insert(overflow_.end(), dishes.begin() + pushed, dishes.end());
+    overflowing_.store(true, std::memory_order_release);
 }
 
 /**
@@ -200,7 +282,38 @@ the end of the queue.
 */
 void StationManager::addDishToQueue(Dish* dish, Dish::DietaryRequest request){
     dish->dietaryAccommodations(request);//make the accomodations
-    dishqueue.push(dish);
+    addDishToQueue(dish);
+}
+
+/**
+* Switches the preparation queue to the concurrent backend.
+* @param capacity The most dishes that can wait in the intake at once
+(rounded up to a power of two).
+* @pre: No other thread is using the station manager.
+* @post: Dishes already in the queue keep their place.
+*/
+void StationManager::enableConcurrentQueue(size_t capacity){
+    drainIntake();
+    intake_.reset(new MpmcQueue<Dish*>(capacity));
+}
+
+// Moves every dish waiting in the concurrent intake to the back of the preparation queue, in batches.
+void StationManager::drainIntake(){
+    if (!intake_) {
+        return;
+    }
+    std::vector<Dish*> batch;
+    batch.reserve(INTAKE_BATCH_SIZE);
+    while (intake_->tryPopBatch(batch, INTAKE_BATCH_SIZE) > 0) {
+        dishqueue.insert(dishqueue.end(), batch.begin(), batch.end());
+        batch.clear();
+    }
+    if (overflowing_.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(overflow_mutex_);
+        dishqueue.insert(dishqueue.end(), overflow_.begin(), overflow_.end());
+        overflow_.clear();
+        overflowing_.store(false, std::memory_order_release);
+    }
 }
 
 /**
@@ -210,22 +323,75 @@ void StationManager::addDishToQueue(Dish* dish, Dish::DietaryRequest request){
 * @return: True if the dish was prepared successfully; false otherwise.
 */
 bool StationManager::prepareNextDish(){
+    drainIntake();
     if (dishqueue.empty()){
         return false;
     }
     Dish* dish = dishqueue.front();//get the front of the queue
 
     //search for station that can complete the order for the dish in the queue, if can, make it and pop from queue and return true
-    for (int i = 0; i < getLength(); i++){ 
-        KitchenStation* station = getEntry(i);
-        if (station->prepareDish(dish->getName())){
-            dishqueue.pop();
+    if (registry_) {
+        // only the stations with enough of every ingredient can prepare it, so skip the rest
+        for (KitchenStation* station : registry_->ableToComplete(dish->getNameId())){
+            if (station->prepareDish(dish->getNameId())){
+                dishqueue.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+    for (KitchenStation* station : *this){
+        if (station->prepareDish(dish->getNameId())){
+            dishqueue.pop_front();
             return true;
         }
     }
     return false;
 }
 
+/**
+* Prepares up to n dishes from the front of the queue.
+* @param n The most dishes to prepare.
+* @return: The number of dishes prepared.
+*/
+int StationManager::prepareDishes(int n){
+    drainIntake();
+    int prepared = 0;
+    while (prepared < n && !dishqueue.empty()){
+        // the run of identical dishes at the front of the queue
+        int dish_id = dishqueue.front()->getNameId();
+        int run = 1;
+        while (prepared + run < n && run < static_cast<int>(dishqueue.size()) && dishqueue[run]->getNameId() == dish_id){
+            run++;
+        }
+
+        // stations only lose stock here, so once one station runs short the rest of the run goes to the
+        // stations after it, exactly as the dishes would have been routed one at a time
+        int made = 0;
+        std::vector<KitchenStation*> stations;
+        if (registry_) {
+            stations = registry_->ableToComplete(dish_id);
+        } else {
+            stations.assign(begin(), end());
+        }
+        for (KitchenStation* station : stations){
+            if (made == run){
+                break;
+            }
+            KitchenStation::Reservation reservation;
+            made += station->reserveIngredients(dish_id, run - made, reservation);
+            reservation.commit();
+        }
+
+        dishqueue.erase(dishqueue.begin(), dishqueue.begin() + made);
+        prepared += made;
+        if (made < run){
+            break; // the next dish can't be prepared anywhere
+        }
+    }
+    return prepared;
+}
+
 /**
 * Displays all dishes in the preparation queue.
 * @pre: None.
@@ -234,29 +400,30 @@ is on its own line).
 */
 void StationManager::displayDishQueue() const {
 
-    std::queue<Dish*> tempqueue = dishqueue;//create a copy of present queue
-
-    //while there is dishes in the copy queue, display their names and pop
-    while (!tempqueue.empty()){
-        Dish* dish = tempqueue.front();
-        std::cout<< dish->getName() << std::endl;
-        tempqueue.pop();
+    //display the names in place, followed by any dishes still waiting in the concurrent intake.
+    //The lines go out in one write and one flush at the end.
+    std::string lines;
+    for (Dish* dish : dishqueue){
+        lines.append(dish->getName()).append("\n");
     }
-
+    if (intake_) {
+        intake_->forEach([&lines](Dish* dish) { lines.append(dish->getName()).append("\n"); });
+        std::lock_guard<std::mutex> lock(overflow_mutex_);
+        for (Dish* dish : overflow_) {
+            lines.append(dish->getName()).append("\n");
+        }
+    }
+    std::cout << lines << std::flush;
 }
 
 /**
 * Clears all dishes from the preparation queue.
 * @pre: None.
-* @post: The dish queue is emptied and all allocated memory is freed.
+* @post: The dish queue is emptied. The dishes are not deleted; the queue never owns them.
 */
 void StationManager::clearDishQueue(){
-    //while there is dishes in the copy queue, peek to get the Dish, pop from queue and delete
-    while (!dishqueue.empty()){
-        Dish* dish = dishqueue.front();
-        dishqueue.pop();
-        delete dish;
-    }
+    drainIntake();
+    dishqueue.clear();
 }
 
 /**
@@ -283,42 +450,25 @@ bool StationManager::replenishStationIngredientFromBackup(const std::string& sta
     if (quantity <= 0) { // Invalid quantity guard
         return false;
     }
-    // Search for the ingredient in the backup stock
-    for (size_t i = 0; i < backupingredients.size(); i++) {
-        if (backupingredients[i].name == ingredient_name) {
-            // Check if the quantity in stock is sufficient
-            if (backupingredients[i].quantity >= quantity) {
-                // Create an ingredient object for replenishment
-                Ingredient ingredient;
-                ingredient.name = ingredient_name;
-                ingredient.quantity = quantity;
-
-                if (replenishIngredientAtStation(station_name, ingredient)){
-                    // Deduct the required quantity from backup stock
-                    backupingredients[i].quantity -= quantity;
-
-                    // Remove the ingredient from backup stock if depleted
-                    if (backupingredients[i].quantity == 0) {
-                        backupingredients.erase(backupingredients.begin() + i);
-                        i--;
-                    }
-
-                    return true;
-
-                }
-                //if couldn't replenish, rturn false
-                return false;
-                
-            }
-            
-            //if not enough quantity, break and return false
-            return false;    
-           
-        }
+    int ingredient_id = SymbolTable::ingredients().lookup(ingredient_name);
+    if (ingredient_id == SymbolTable::NO_ID) {
+        return false;
     }
-
-    // Return false if ingredient not found 
-    return false;
+    KitchenStation* station = findStation(station_name);
+    if (station == nullptr) {
+        return false; //if couldn't replenish, return false
+    }
+    // Deduct the quantity from backup stock if there is enough; a depleted entry is removed
+    if (!backupingredients.take(ingredient_id, quantity)) {
+        return false;
+    }
+    // Create an ingredient object for replenishment
+    Ingredient ingredient;
+    ingredient.name = ingredient_name;
+    ingredient.quantity = quantity;
+    ingredient.id = ingredient_id;
+    station->replenishStationIngredients(ingredient);
+    return true;
 
 
 
@@ -335,8 +485,7 @@ ingredients.
 * @return True if the ingredients were added; false otherwise.
 */
 bool StationManager::addBackupIngredients(const std::vector<Ingredient>& ingredients){
-    backupingredients = ingredients;
-    
+    backupingredients.assign(ingredients);
     return true;
 }
 
@@ -351,17 +500,8 @@ is increased by the ingredient's quantity.
 * @return True if the ingredient was added; false otherwise.
 */
 bool StationManager::addBackupIngredient(const Ingredient& ingredient){
-    
-    //loop through, if ingredient already exists, increase quantity and return false
-    for (size_t i = 0; i < backupingredients.size(); i++){
-        if (backupingredients[i].name == ingredient.name){
-            backupingredients[i].quantity += ingredient.quantity;
-            return true;
-        }
-    }
-
-    //if ingredient was added, return true
-    backupingredients.push_back(ingredient);
+    //if ingredient already exists, its quantity is increased; otherwise it is added
+    backupingredients.add(ingredient);
     return true;
 }
 
@@ -385,7 +525,10 @@ stays in the queue in its original order...
 in the same order
 */
 void StationManager::processAllDishes() {
+    drainIntake();
     Dish* firstUnpreparedDish = nullptr; // Pointer to track the first unprepared dish.
+    std::vector<KitchenEventSink::Event> events; // the stations' events for the current dish
+    parking_ = true;
 
     while (!dishqueue.empty()) {
         Dish* dish = dishqueue.front();
@@ -394,123 +537,312 @@ void StationManager::processAllDishes() {
         if (firstUnpreparedDish == dish) {
             break; // Exit the loop to prevent infinite cycling.
         }
-        dishqueue.pop();
+        dishqueue.pop_front();
 
         bool dishCompleted = false;
-        std::cout << "PREPARING DISH: " << dish->getName() << std::endl;
-
-        for (int i = 0; i < getLength(); i++) {
-            if (dishCompleted) break;
+        sink_->emit({KitchenEventSink::EventType::DISH_STARTED, dish->getNameId(), SymbolTable::NO_ID});
+
+        auto parked = parked_.find(dish->getNameId());
+        if (parked != parked_.end() && parked->second.ingredient_ids == dish->getIngredientIds()
+            && parked->second.required_quantities == dish->getRequiredQuantities()) {
+            // nothing it was short of has been replenished since, so it fails the same way again
+            for (const KitchenEventSink::Event& event : parked->second.events) {
+                sink_->emit(event);
+            }
+        }
+        else {
+            bool parkable = true;
+            std::vector<int> waits_on = dish->getIngredientIds();
+            events.clear();
+            for (KitchenStation* station : *this) {
+                Attempt attempt = attemptDishAtStation(station, dish, events);
+                if (attempt == Attempt::PREPARED) {
+                    dishCompleted = true;
+                    break;
+                }
+                if (attempt == Attempt::NOT_PREPARED) {
+                    parkable = false;
+                }
+                else if (attempt == Attempt::NOT_REPLENISHED) {
+                    // the station checks its own recipe, so its ingredients can unblock the dish too
+                    const std::vector<int>& station_ids = station->getDish(dish->getNameId())->getIngredientIds();
+                    waits_on.insert(waits_on.end(), station_ids.begin(), station_ids.end());
+                }
+            }
 
-            KitchenStation* station = getEntry(i);
-            std::cout << station->getName() << " attempting to prepare " << dish->getName() << "..." << std::endl;
+            for (const KitchenEventSink::Event& event : events) {
+                sink_->emit(event);
+            }
 
-            // Check if the station can prepare the dish.
-            bool found = false;
-            std::vector<Dish*> dishes = station->getDishes();
-            for (size_t j = 0; j < dishes.size(); j++) {
-                if (dishes[j]->getName() == dish->getName()) {
-                    found = true;
-                    break;
+            if (!dishCompleted && parkable) {
+                ParkedDish& entry = parked_[dish->getNameId()];
+                entry.ingredient_ids = dish->getIngredientIds();
+                entry.required_quantities = dish->getRequiredQuantities();
+                entry.events = events;
+                for (int id : waits_on) {
+                    parked_by_ingredient_[id].push_back(dish->getNameId());
                 }
             }
+        }
 
-            if (!found) {
-                std::cout << station->getName() << ": Dish not available. Moving to next station..." << std::endl;
-                continue;
+        if (dishCompleted) {
+            sink_->emit({KitchenEventSink::EventType::DISH_PREPARED, dish->getNameId(), SymbolTable::NO_ID});
+        }
+        else {
+            sink_->emit({KitchenEventSink::EventType::DISH_NOT_PREPARED, dish->getNameId(), SymbolTable::NO_ID});
+
+            // Track the first unprepared dish.
+            if (firstUnpreparedDish == nullptr) {
+                firstUnpreparedDish = dish;
             }
 
+            dishqueue.push_back(dish); // Requeue the unprepared dish.
+        } 
+    }
+    parking_ = false;
+    parked_.clear();
+    parked_by_ingredient_.clear();
 
-            //if cant complete, try to replenish ingredients
-            if (!station->canCompleteOrder(dish->getName())) {
-                std::cout << station->getName() << ": Insufficient ingredients. Replenishing ingredients..." << std::endl;
-
-                std::vector<Ingredient> stock = station->getIngredientsStock();
-                std::vector<Ingredient> required = dish->getIngredients();
-                
-
-            
-                bool cantComplete = false;//flag indicating if you can complete a dish after replenishing
-                
-                //loop through required ingredients, replenish if not enough in stock, and break out if cant replenish
-                for (const auto& req : required) {
-                    bool ingredientFoundInStock = false;
-
-                    // Check if the required ingredient is in the stock.
-                    for (auto& st : stock) {
-                        if (st.name == req.name) {
-                            ingredientFoundInStock = true;
-                            int deficit = req.required_quantity - st.quantity;
-                            // std::cout << "Required quantity: " << req.required_quantity << std::endl;
-                            // std::cout << "Stock quantity: " << st.quantity << std::endl;
-                            // std::cout << "Deficit: " << deficit << std::endl;
-
-                            // Replenish if there's a deficit.
-                            if (deficit > 0) { 
-                                if (!replenishStationIngredientFromBackup(station->getName(), req.name, deficit)) {
-                                    std::cout << station->getName() << ": Unable to replenish ingredients. Failed to prepare " << dish->getName() << "." << std::endl;
-                                    cantComplete = true;
-                                    break;
-                                }
-                                
-                            }
-                            break; // if ingredient found in stock, break and look for next required ingredient
-                        }
-                    }
-
-                    if (cantComplete) {
-                        break;
-                    }
-
-                    // If the ingredient is not found in the stock, try to replenish it from backup.
-                    if (!ingredientFoundInStock) {
-                        int deficit = req.required_quantity;
-                        //std::cout << "Required ingredient not found in stock: " << req.name << ". Attempting to replenish from backup." << std::endl;
-
-                        if (!replenishStationIngredientFromBackup(station->getName(), req.name, deficit)) {
-                            std::cout << station->getName() << ": Unable to replenish ingredients. Failed to prepare " << dish->getName() << "." << std::endl;
-                            cantComplete = true;
-                            break;
-                        }
-
-                        
-                    }  
-                }
-  
-                if (cantComplete) {
+    sink_->emit({KitchenEventSink::EventType::ALL_PROCESSED, SymbolTable::NO_ID, SymbolTable::NO_ID});
+    sink_->flush();
+}
 
-                    continue; // Skip to the next station.
-                }
+/**
+* Sets where dish processing is reported.
+* @param sink The sink to emit to, or nullptr for the buffered text sink on std::cout.
+*/
+void StationManager::setEventSink(KitchenEventSink* sink) {
+    sink_ = (sink != nullptr) ? sink : &console_sink_;
+}
+
+/**
+* Unparks the dishes processAllDishes parked on an ingredient, so they are attempted again.
+* @param ingredient_id The interned name of an ingredient whose stock went up at some station.
+*/
+void StationManager::wakeDishesNeeding(int ingredient_id) {
+    auto waiting = parked_by_ingredient_.find(ingredient_id);
+    if (waiting == parked_by_ingredient_.end()) {
+        return;
+    }
+    for (int dish_id : waiting->second) {
+        parked_.erase(dish_id);
+    }
+    parked_by_ingredient_.erase(waiting);
+}
+
+/**
+* Processes all dishes in the queue using one worker thread per station.
+* @param deterministic If true, dishes are handed out one at a time in queue order.
+* @post: Same as processAllDishes(), see the header for details.
+*/
+void StationManager::processAllDishesParallel(bool deterministic) {
+    drainIntake();
+
+    // one worker per station, in list order
+    std::vector<std::unique_ptr<StationWorker>> workers;
+    for (KitchenStation* station : *this) {
+        workers.push_back(std::make_unique<StationWorker>(station));
+    }
 
-                if (!cantComplete){
-                    std::cout << station->getName() << ": Ingredients replenished." << std::endl;
+    struct DishJob {
+        Dish* dish;
+        bool prepared;
+        std::vector<KitchenEventSink::Event> events; // this dish's events, emitted when the dish is finished
+    };
+    auto start = [](DishJob& job, Dish* dish) {
+        job.dish = dish;
+        job.prepared = false;
+        job.events.push_back({KitchenEventSink::EventType::DISH_STARTED, dish->getNameId(), SymbolTable::NO_ID});
+    };
+
+    std::mutex done_mutex;
+    std::condition_variable done_cv;
+    size_t pending = 0;
+
+    auto finish = [&](DishJob& job) {
+        job.events.push_back({job.prepared ? KitchenEventSink::EventType::DISH_PREPARED
+                                           : KitchenEventSink::EventType::DISH_NOT_PREPARED,
+                              job.dish->getNameId(), SymbolTable::NO_ID});
+        std::lock_guard<std::mutex> lock(done_mutex); // notify under the lock so the dispatcher can't return early
+        if (!deterministic) {
+            for (const KitchenEventSink::Event& event : job.events) {
+                sink_->emit(event);
+            }
+        }
+        pending--;
+        done_cv.notify_all();
+    };
+
+    // sends a job to the first station at or after `from` that carries the dish; stations that don't
+    // carry it only read their dish index, so they are logged here instead of on their own worker
+    std::function<void(DishJob&, size_t)> route = [&](DishJob& job, size_t from) {
+        for (size_t i = from; i < workers.size(); i++) {
+            KitchenStation* station = workers[i]->getStation();
+            if (!station->carriesDish(job.dish->getNameId())) {
+                attemptDishAtStation(station, job.dish, job.events);
+                continue;
+            }
+            DishJob* next_job = &job;
+            workers[i]->post([&, next_job, i, station]() {
+                if (attemptDishAtStation(station, next_job->dish, next_job->events) == Attempt::PREPARED) {
+                    next_job->prepared = true;
+                    finish(*next_job);
+                }
+                else {
+                    route(*next_job, i + 1);
                 }
+            });
+            return;
+        }
+        finish(job);
+    };
+
+    if (deterministic) {
+        // same loop as processAllDishes(), but each dish is cooked on its stations' workers
+        Dish* firstUnpreparedDish = nullptr;
+        while (!dishqueue.empty() && dishqueue.front() != firstUnpreparedDish) {
+            DishJob job;
+            start(job, dishqueue.front());
+            dishqueue.pop_front();
+
+            pending = 1;
+            route(job, 0);
+            {
+                std::unique_lock<std::mutex> lock(done_mutex);
+                done_cv.wait(lock, [&] { return pending == 0; });
             }
-            
-            // Attempt to prepare the dish.
-            if (station->prepareDish(dish->getName())) {
-                std::cout << station->getName() << ": Successfully prepared " << dish->getName() << "." << std::endl;
-                dishCompleted = true;
-                break;
+            for (const KitchenEventSink::Event& event : job.events) {
+                sink_->emit(event);
             }
-            //std::cout<<"result of trying to prepare dish: "<<station->prepareDish(dish->getName())<<std::endl;
 
+            if (!job.prepared) {
+                if (firstUnpreparedDish == nullptr) {
+                    firstUnpreparedDish = job.dish;
+                }
+                dishqueue.push_back(job.dish); // Requeue the unprepared dish.
+            }
+        }
+    }
+    else {
+        // every dish currently in the queue is attempted once, all routed up front
+        std::vector<DishJob> jobs(dishqueue.size());
+        for (DishJob& job : jobs) {
+            start(job, dishqueue.front());
+            dishqueue.pop_front();
         }
 
-        if (!dishCompleted) {
-            std::cout << dish->getName() << " was not prepared." << std::endl;
+        pending = jobs.size();
+        for (DishJob& job : jobs) {
+            route(job, 0);
+        }
+        {
+            std::unique_lock<std::mutex> lock(done_mutex);
+            done_cv.wait(lock, [&] { return pending == 0; });
+        }
 
-            // Track the first unprepared dish.
-            if (firstUnpreparedDish == nullptr) {
-                firstUnpreparedDish = dish;
+        // Requeue the unprepared dishes in their original order.
+        for (const DishJob& job : jobs) {
+            if (!job.prepared) {
+                dishqueue.push_back(job.dish);
             }
+        }
+    }
+    sink_->emit({KitchenEventSink::EventType::ALL_PROCESSED, SymbolTable::NO_ID, SymbolTable::NO_ID});
+    sink_->flush();
+}
 
-            dishqueue.push(dish); // Requeue the unprepared dish.
-        } 
+/**
+* Tops a station up from the backup stock with everything it is short of for a recipe.
+* @param station The station to replenish.
+* @param dish The dish whose recipe sets the required quantities.
+* @post: Each recipe ingredient's deficit is worked out against the station's stock as it is now:
+the required quantity minus the stock, or the whole required quantity if the ingredient is not stocked.
+If the backup holds enough for every deficit, all of them are moved to the station and depleted
+backup entries are removed; otherwise nothing changes.
+* @return: True if the deficits were transferred; false otherwise.
+*/
+bool StationManager::replenishDeficitsFromBackup(KitchenStation* station, const Dish* dish) {
+    std::vector<const Ingredient*> short_of;    // the recipe lines with a deficit
+    std::vector<std::pair<int, int>> deficits;  // (ingredient ID, deficit) for each of them
+
+    // work out the whole deficit vector before anything moves
+    for (const Ingredient& req : dish->getIngredients()) {
+        int deficit = req.required_quantity;
+        if (station->isStocked(req.id)) {
+            deficit -= station->getStockQuantity(req.id);
+            if (deficit <= 0) {
+                continue; // enough in stock, look at the next required ingredient
+            }
+        } else if (deficit <= 0) {
+            return false; // nothing to draw for an ingredient that isn't stocked
+        }
+        short_of.push_back(&req);
+        deficits.emplace_back(req.id, deficit);
+    }
 
-        std::cout << std::endl;
+    // the backup validates and draws every deficit at once, or none of them
+    if (!backupingredients.takeAll(deficits)) {
+        return false;
     }
-    std::cout << std::endl;
-    std::cout << "All dishes have been processed." << std::endl;
+    for (size_t i = 0; i < short_of.size(); i++) {
+        Ingredient ingredient;
+        ingredient.name = short_of[i]->name;
+        ingredient.quantity = deficits[i].second;
+        ingredient.id = short_of[i]->id;
+        station->replenishStationIngredients(ingredient);
+        if (parking_) {
+            wakeDishesNeeding(ingredient.id);
+        }
+    }
+    return true;
 }
 
+/**
+* Attempts to prepare a dish at one station, replenishing from the backup stock if needed.
+* @param station The station to try.
+* @param dish The dish to prepare.
+* @param events The station's events for this attempt are appended here.
+* @post: On success the ingredients are taken from the station's stock.
+* @return: PREPARED if the station prepared the dish; otherwise why it didn't.
+*/
+StationManager::Attempt StationManager::attemptDishAtStation(KitchenStation* station, Dish* dish,
+                                                             std::vector<KitchenEventSink::Event>& events) {
+    using EventType = KitchenEventSink::EventType;
+    const int dish_id = dish->getNameId();
+    const int station_id = station->getNameId();
+    events.push_back({EventType::ATTEMPTING, dish_id, station_id});
+
+    // Check if the station can prepare the dish.
+    if (!station->carriesDish(dish_id)) {
+        events.push_back({EventType::NOT_CARRIED, dish_id, station_id});
+        return Attempt::NOT_CARRIED;
+    }
+
+    //if cant complete, try to replenish ingredients
+    if (!station->canCompleteOrder(dish_id)) {
+        events.push_back({EventType::INSUFFICIENT_STOCK, dish_id, station_id});
+
+        //replenish everything the station is short of in one go, or nothing if the backup can't cover it
+        if (!replenishDeficitsFromBackup(station, dish)) {
+            events.push_back({EventType::REPLENISH_FAILED, dish_id, station_id});
+            return Attempt::NOT_REPLENISHED; // Skip to the next station.
+        }
+        events.push_back({EventType::REPLENISHED, dish_id, station_id});
+    }
+
+    // Attempt to prepare the dish.
+    if (station->prepareDish(dish_id)) {
+        events.push_back({EventType::PREPARED, dish_id, station_id});
+        if (parking_) {
+            // a recipe line with a negative requirement gives stock back to the station
+            const Dish* recipe = station->getDish(dish_id);
+            for (size_t i = 0; i < recipe->getIngredientIds().size(); i++) {
+                if (recipe->getRequiredQuantities()[i] < 0) {
+                    wakeDishesNeeding(recipe->getIngredientIds()[i]);
+                }
+            }
+        }
+        return Attempt::PREPARED;
+    }
+    return Attempt::NOT_PREPARED;
+}
@@ -10,13 +10,35 @@
 #include "LinkedList.hpp"
 #include "KitchenStation.hpp"
 #include "Dish.hpp"
+#include "MpmcQueue.hpp"
+#include "StationRegistry.hpp"
+#include "BackupInventory.hpp"
+#include "KitchenEventSink.hpp"
+#include "TextEventSink.hpp"
 #include <string>
 #include <queue>
+#include <deque>
+#include <memory>
 #include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <atomic>
+#include <functional>
 
 
-class StationManager : public LinkedList<KitchenStation*> {
+// The station list is inherited protectedly: station_index_ has to follow every insertion and removal,
+// so stations are only added, removed and moved through the members below. The read-only list
+// members are re-exported as they were.
+class StationManager : protected LinkedList<KitchenStation*> {
 public:
+    using LinkedList<KitchenStation*>::isEmpty;
+    using LinkedList<KitchenStation*>::getLength;
+    using LinkedList<KitchenStation*>::getEntry;
+    using LinkedList<KitchenStation*>::getPointerTo;
+    using LinkedList<KitchenStation*>::getHeadNode;
+    using LinkedList<KitchenStation*>::begin;
+    using LinkedList<KitchenStation*>::end;
+
     /**
      * Default Constructor
      * @post: Initializes an empty station manager.
@@ -27,14 +49,15 @@ public:
     /**
      * Adds a new station to the station manager.
      * @param station A pointer to a KitchenStation object.
-     * @post: Inserts the station into the linked list.
+     * @post: Inserts the station at the end of the linked list and indexes it by name.
+     * @return: True if the station was added; false if it is null or a station with the same name already exists.
      */
     bool addStation(KitchenStation* station);
 
     /**
      * Removes a station from the station manager by name.
      * @param station_name A string representing the station's name.
-     * @post: Removes the station from the list and deallocates it.
+     * @post: Removes the station from the list. The station itself is not deleted; it still belongs to the caller.
      * @return: True if the station was found and removed; false otherwise.
      */
     bool removeStation(const std::string& station_name);
@@ -63,6 +86,15 @@ public:
      */
     bool mergeStations(const std::string& station_name1, const std::string& station_name2);
 
+    /**
+     * Keeps a contiguous StationRegistry next to the station list, in the same order.
+     * canCompleteOrder and prepareNextDish then go straight to the stations that carry the dish and
+     * have all of its ingredients in stock.
+     * @pre: The stations are not in another registry.
+     * @post: Every station added, removed or moved to the front from now on is mirrored in the registry.
+     */
+    void enableStationRegistry();
+
     /**
      * Assigns a dish to a specific station.
      * @param station_name A string representing the station's name.
@@ -101,6 +133,8 @@ public:
     * Retrieves the current dish preparation queue.
     * @return A copy of the queue containing pointers to Dish objects.
     * @post: The dish preparation queue is returned unchanged.
+    * Called from the kitchen thread, it may run while other threads add dishes; a dish added meanwhile
+    may be left out of the copy.
     */
     std::queue<Dish*> getDishQueue() const;
 
@@ -112,6 +146,12 @@ public:
     */
     std::vector<Ingredient> getBackupIngredients() const;
 
+    /**
+    * Visits the backup ingredients in list order without copying them.
+    * @param visit Called with each backup ingredient. It must not change the backup stock.
+    */
+    void forEachBackupIngredient(const std::function<void(const Ingredient&)>& visit) const;
+
     /**
     * Sets the current dish preparation queue.
     * @param dish_queue A queue containing pointers to Dish objects.
@@ -127,6 +167,8 @@ public:
     * @param dish A pointer to a dynamically allocated Dish object.
     * @pre: The dish pointer is not null.
     * @post: The dish is added to the end of the queue.
+    * Once enableConcurrentQueue() has been called, this may be called from many threads at once;
+    while the concurrent intake is full, dishes go to a locked overflow list until the next drain.
     */
     void addDishToQueue(Dish* dish);
 
@@ -141,6 +183,27 @@ public:
     */
     void addDishToQueue(Dish* dish, Dish::DietaryRequest request);
 
+    /**
+    * Adds a burst of dishes to the preparation queue without dietary accommodations.
+    * @param dishes Pointers to dynamically allocated Dish objects, in order.
+    * @pre: None of the pointers is null.
+    * @post: The dishes are added to the end of the queue in order, as if by addDishToQueue
+    one at a time. With the concurrent intake they are claimed with as few compare-and-swaps as
+    the free room allows, and whatever does not fit goes to the overflow list under one lock.
+    */
+    void addDishesToQueue(const std::vector<Dish*>& dishes);
+
+    /**
+    * Switches the preparation queue to the concurrent backend: dishes are added through a bounded
+    lock-free multi-producer/multi-consumer ring buffer, which prepareNextDish, processAllDishes and
+    the other queue operations drain into the preparation queue in batches.
+    * @param capacity The most dishes that can wait in the intake at once (rounded up to a power of two).
+    * @pre: No other thread is using the station manager. Afterwards only addDishToQueue may be called
+    from several threads at once; the other queue operations belong to a single kitchen thread.
+    * @post: Dishes already in the queue keep their place.
+    */
+    void enableConcurrentQueue(size_t capacity);
+
     /**
     * Prepares the next dish in the queue if possible.
     * @pre: The dish queue is not empty.
@@ -149,18 +212,30 @@ public:
     */
     bool prepareNextDish();
 
+    /**
+    * Prepares up to n dishes from the front of the queue, with the same result as calling
+    prepareNextDish() until it fails or n dishes are done.
+    * Consecutive identical dishes are handled together: each station is checked once for the
+    whole run and deducts the combined ingredients in one go.
+    * @param n The most dishes to prepare.
+    * @post: The prepared dishes are removed from the front of the queue.
+    * @return: The number of dishes prepared.
+    */
+    int prepareDishes(int n);
+
     /**
     * Displays all dishes in the preparation queue.
     * @pre: None.
     * @post: Outputs the names of the dishes in the queue in order (each name
-    is on its own line).
+    is on its own line), followed by any dishes still waiting in the
+    concurrent intake. Nothing is copied. As with getDishQueue, other threads may add dishes meanwhile.
     */
    void displayDishQueue() const;
 
     /**
     * Clears all dishes from the preparation queue.
     * @pre: None.
-    * @post: The dish queue is emptied and all allocated memory is freed.
+    * @post: The dish queue is emptied. The dishes are not deleted; the queue never owns them.
     */
     void clearDishQueue();
 
@@ -227,15 +302,96 @@ public:
     */
     void processAllDishes();
 
+    /**
+    * Processes all dishes in the queue using one worker thread per station.
+    * @param deterministic If true, dishes are handed out one at a time in queue order,
+    so stock, backup use and output match processAllDishes() exactly.
+    If false, all dishes are routed at once and stations cook concurrently.
+    * @pre: Stations, their dishes and the queue are not changed from other threads while this runs.
+    * @post: With the deterministic option the results and output are the same as processAllDishes().
+    Without it, every dish in the queue is attempted once at the stations in list order,
+    each dish's lines are displayed together when the dish finishes (so dishes can appear out
+    of queue order), and dishes that could not be prepared stay in the queue in their original order.
+    */
+    void processAllDishesParallel(bool deterministic = false);
+
+    /**
+    * Sets where processAllDishes and processAllDishesParallel report what happens to each dish.
+    * @param sink The sink to emit to, or nullptr for the default: the usual lines, buffered, on std::cout.
+    The station manager doesn't own it, and it must outlive its use here.
+    * @post: The next processAllDishes or processAllDishesParallel emits to the sink and flushes it at the end.
+    */
+    void setEventSink(KitchenEventSink* sink);
+
 private:
-    // helper function to get index of a station by name
-    int getStationIndex(const std::string& station_name) const;
+    // how a dish's attempt at one station ended
+    enum class Attempt {
+        PREPARED,
+        NOT_CARRIED,      // the station doesn't carry the dish
+        NOT_REPLENISHED,  // short of ingredients and the backup couldn't cover them
+        NOT_PREPARED      // replenished (or in stock) but the station still couldn't prepare it
+    };
+
+    // helper that attempts a dish at one station, replenishing from backup if needed, and appends the
+    // station's events to events.
+    Attempt attemptDishAtStation(KitchenStation* station, Dish* dish, std::vector<KitchenEventSink::Event>& events);
+
+    // helper that tops a station up from backup with everything it is short of for a recipe, or with
+    // nothing at all if the backup can't cover every deficit. Returns true if the transfer was made.
+    bool replenishDeficitsFromBackup(KitchenStation* station, const Dish* dish);
+
+    // A dish that failed at every station only because it wasn't carried or the backup couldn't cover
+    // its deficits. Stock and backup only go down while the queue drains, so it fails the same way, with
+    // the same events, until one of the ingredients it was short of goes back up. Until then
+    // processAllDishes replays its events instead of attempting it again.
+    struct ParkedDish {
+        std::vector<int> ingredient_ids;     // the recipe it was parked with (Dish::getIngredientIds())
+        std::vector<int> required_quantities;
+        std::vector<KitchenEventSink::Event> events; // the station events of its last attempt
+    };
+    // parked dishes by interned name, and the parked dish names waiting on each ingredient ID
+    std::unordered_map<int, ParkedDish> parked_;
+    std::unordered_map<int, std::vector<int>> parked_by_ingredient_;
+    bool parking_ = false; // only while processAllDishes runs
 
-    // storing pointers to dynamically allocated Dish objects that need to be prepared.
-    std::queue<Dish*> dishqueue;
+    // wakes (unparks) every dish waiting on an ingredient whose stock at some station went up
+    void wakeDishesNeeding(int ingredient_id);
+
+    // helper function to get the node that follows prev in the list (the head if prev is nullptr)
+    Node<KitchenStation*>* nodeAfter(Node<KitchenStation*>* prev) const;
+
+    // maps each station name to the node *before* that station (nullptr for the head), so a station
+    // can be found, unlinked or moved without walking the list. Stations must not be renamed while managed.
+    std::unordered_map<std::string, Node<KitchenStation*>*> station_index_;
+
+    // moves every dish waiting in the concurrent intake to the back of dishqueue
+    void drainIntake();
+
+    // dense mirror of the station list, only set after enableStationRegistry()
+    std::unique_ptr<StationRegistry> registry_;
+
+    // storing pointers to the Dish objects that need to be prepared. The dishes are owned elsewhere
+    // (usually by the shift's DishArena), often by the same owner as a station's copy.
+    // A deque so the queue can be displayed in place.
+    std::deque<Dish*> dishqueue;
+
+    // concurrent intake, only set after enableConcurrentQueue()
+    std::unique_ptr<MpmcQueue<Dish*>> intake_;
+    static const size_t INTAKE_BATCH_SIZE = 64;
+
+    // dishes added while the intake was full. Once it is in use every producer appends here until the
+    // next drain, so each producer's dishes stay in order behind whatever was already in the intake.
+    std::vector<Dish*> overflow_;
+    std::atomic<bool> overflowing_{false};
+    mutable std::mutex overflow_mutex_;
 
     //representing the backup stock ofingredients that can be used to replenish station ingredients when needed.
-    std::vector<Ingredient> backupingredients;
+    //Sharded by ingredient, so the station workers in processAllDishesParallel can draw from it at the same time.
+    BackupInventory backupingredients;
+
+    // where dish processing is reported; console_sink_ unless setEventSink() was given another
+    TextEventSink console_sink_;
+    KitchenEventSink* sink_;
 };
 
 #endif // STATIONMANAGER_HPP
\ No newline at end of file
@@ -0,0 +1,278 @@
+#include "StationRegistry.hpp"
+#include "KitchenStation.hpp"
+#include "StockKernel.hpp"
+#include <algorithm>
+
+StationRegistry::StationRegistry() : slot_words_(1) {
+}
+
+StationRegistry::~StationRegistry() {
+    for (KitchenStation* station : stations_) {
+        if (station != nullptr) {
+            station->registry_ = nullptr;
+            station->registry_handle_ = NO_HANDLE;
+        }
+    }
+}
+
+StationRegistry::Handle StationRegistry::add(KitchenStation* station) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Handle handle;
+    if (!free_slots_.empty()) {
+        handle = free_slots_.back();
+        free_slots_.pop_back();
+    } else {
+        handle = static_cast<Handle>(stations_.size());
+        stations_.push_back(nullptr);
+        fitSlot(handle);
+    }
+
+    // copy in the hot fields; the station reports every later change through the hooks
+    stations_[handle] = station;
+    for (const Dish* dish : station->getDishes()) {
+        setBit(capability_, dish->getNameId(), handle, true);
+    }
+    for (const Ingredient& ingredient : station->getIngredientsStock()) {
+        setBit(stocked_, ingredient.id, handle, true);
+        setQuantity(ingredient.id, handle, ingredient.quantity);
+    }
+    for (const Dish* dish : station->getDishes()) {
+        refreshReady(handle, dish);
+    }
+    order_.push_back(handle);
+
+    station->registry_ = this;
+    station->registry_handle_ = handle;
+    return handle;
+}
+
+bool StationRegistry::remove(KitchenStation* station) {
+    if (station == nullptr || station->registry_ != this) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    Handle handle = station->registry_handle_;
+    // clear the station's column; its bits are exactly its dishes and its stock
+    for (const Dish* dish : station->getDishes()) {
+        setBit(capability_, dish->getNameId(), handle, false);
+        setBit(ready_, dish->getNameId(), handle, false);
+    }
+    for (const Ingredient& ingredient : station->getIngredientsStock()) {
+        setBit(stocked_, ingredient.id, handle, false);
+        setQuantity(ingredient.id, handle, StockKernel::NOT_STOCKED);
+    }
+    stations_[handle] = nullptr;
+    order_.erase(std::find(order_.begin(), order_.end(), handle));
+    free_slots_.push_back(handle);
+
+    station->registry_ = nullptr;
+    station->registry_handle_ = NO_HANDLE;
+    return true;
+}
+
+bool StationRegistry::moveToFront(KitchenStation* station) {
+    if (station == nullptr || station->registry_ != this) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    // shift the stations before it back by one, keeping their order
+    auto position = std::find(order_.begin(), order_.end(), station->registry_handle_);
+    std::rotate(order_.begin(), position, position + 1);
+    return true;
+}
+
+std::vector<KitchenStation*> StationRegistry::ableToComplete(int dish_id) const {
+    std::vector<KitchenStation*> stations;
+    std::vector<bool> recheck; // stations[i] still has to check its own recipe
+    std::unique_lock<std::mutex> lock(mutex_);
+    refreshIfRecipesChanged(dish_id);
+    size_t row = static_cast<size_t>(dish_id) * slot_words_;
+    if (popcount(ready_, dish_id) == 0) {
+        return stations;
+    }
+
+    // the first ready station's recipe is checked against every station in one sweep; the few
+    // stations whose copy of the dish differs are left out of the sweep and checked one by one
+    const Dish* recipe = nullptr;
+    std::vector<uint64_t> shared(slot_words_, 0);
+    std::vector<uint64_t> differs(slot_words_, 0);
+    for (Handle handle : order_) {
+        if (!((ready_[row + handle / WORD_BITS] >> (handle % WORD_BITS)) & 1)) {
+            continue;
+        }
+        const Dish* dish = stations_[handle]->findDish(dish_id);
+        if (recipe == nullptr) {
+            recipe = dish;
+        }
+        bool same = dish->getIngredientIds() == recipe->getIngredientIds() &&
+                    dish->getRequiredQuantities() == recipe->getRequiredQuantities();
+        (same ? shared : differs)[handle / WORD_BITS] |= uint64_t(1) << (handle % WORD_BITS);
+    }
+
+    // an ingredient without a quantity row has never been stocked anywhere, so no station has it
+    size_t row_size = static_cast<size_t>(slot_words_) * WORD_BITS;
+    const std::vector<int>& ids = recipe->getIngredientIds();
+    const std::vector<int>& required = recipe->getRequiredQuantities();
+    for (size_t i = 0; i < ids.size(); i++) {
+        size_t row = static_cast<size_t>(ids[i]) * row_size;
+        if (ids[i] < 0 || row >= quantities_.size()) {
+            std::fill(shared.begin(), shared.end(), 0);
+            break;
+        }
+        StockKernel::coverRow(&quantities_[row], slot_words_, required[i], shared.data());
+    }
+
+    for (Handle handle : order_) {
+        uint64_t bit = uint64_t(1) << (handle % WORD_BITS);
+        if ((shared[handle / WORD_BITS] | differs[handle / WORD_BITS]) & bit) {
+            stations.push_back(stations_[handle]);
+            recheck.push_back((differs[handle / WORD_BITS] & bit) != 0);
+        }
+    }
+    lock.unlock();
+
+    // stations lock their stock before reporting to the registry, so their own checks run unlocked here
+    size_t kept = 0;
+    for (size_t i = 0; i < stations.size(); i++) {
+        if (!recheck[i] || stations[i]->canCompleteOrder(dish_id)) {
+            stations[kept++] = stations[i];
+        }
+    }
+    stations.resize(kept);
+    return stations;
+}
+
+void StationRegistry::dishAssigned(Handle handle, int dish_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    setBit(capability_, dish_id, handle, true);
+    refreshReady(handle, stations_[handle]->findDish(dish_id));
+}
+
+void StationRegistry::stockChanged(Handle handle, int ingredient_id, int quantity) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    setQuantity(ingredient_id, handle, quantity);
+    bool stocked = quantity != StockKernel::NOT_STOCKED;
+    if (testBit(stocked_, ingredient_id, handle) == stocked) {
+        return;
+    }
+    setBit(stocked_, ingredient_id, handle, stocked);
+
+    // only the station's dishes that use this ingredient can change readiness
+    for (const Dish* dish : stations_[handle]->getDishes()) {
+        for (const Ingredient& ingredient : dish->getIngredients()) {
+            if (ingredient.id == ingredient_id) {
+                refreshReady(handle, dish);
+                break;
+            }
+        }
+    }
+}
+
+void StationRegistry::setBit(std::vector<uint64_t>& rows, int id, int slot, bool value) const {
+    if (id < 0) {
+        return;
+    }
+    size_t row = static_cast<size_t>(id) * slot_words_;
+    if (row >= rows.size()) {
+        if (!value) {
+            return;
+        }
+        rows.resize(row + slot_words_, 0);
+    }
+    uint64_t mask = uint64_t(1) << (slot % WORD_BITS);
+    uint64_t& word = rows[row + slot / WORD_BITS];
+    word = value ? (word | mask) : (word & ~mask);
+}
+
+bool StationRegistry::testBit(const std::vector<uint64_t>& rows, int id, int slot) const {
+    size_t row = static_cast<size_t>(id) * slot_words_;
+    if (id < 0 || row >= rows.size()) {
+        return false;
+    }
+    return (rows[row + slot / WORD_BITS] >> (slot % WORD_BITS)) & 1;
+}
+
+void StationRegistry::setQuantity(int ingredient_id, int slot, int quantity) {
+    if (ingredient_id < 0) {
+        return;
+    }
+    size_t row_size = static_cast<size_t>(slot_words_) * WORD_BITS;
+    size_t row = static_cast<size_t>(ingredient_id) * row_size;
+    if (row >= quantities_.size()) {
+        quantities_.resize(row + row_size, StockKernel::NOT_STOCKED);
+    }
+    quantities_[row + slot] = quantity;
+}
+
+void StationRegistry::fitSlot(int slot) {
+    if (slot < slot_words_ * WORD_BITS) {
+        return;
+    }
+    // restride every table, doubling the row width to keep this rare
+    int new_words = std::max(slot_words_ * 2, slot / WORD_BITS + 1);
+    for (std::vector<uint64_t>* rows : {&capability_, &stocked_, &ready_}) {
+        size_t row_count = rows->size() / slot_words_;
+        std::vector<uint64_t> widened(row_count * new_words, 0);
+        for (size_t r = 0; r < row_count; r++) {
+            std::copy_n(rows->begin() + r * slot_words_, slot_words_, widened.begin() + r * new_words);
+        }
+        rows->swap(widened);
+    }
+    size_t row_size = static_cast<size_t>(slot_words_) * WORD_BITS;
+    size_t new_row_size = static_cast<size_t>(new_words) * WORD_BITS;
+    size_t row_count = quantities_.size() / row_size;
+    std::vector<int> widened(row_count * new_row_size, StockKernel::NOT_STOCKED);
+    for (size_t r = 0; r < row_count; r++) {
+        std::copy_n(quantities_.begin() + r * row_size, row_size, widened.begin() + r * new_row_size);
+    }
+    quantities_.swap(widened);
+    slot_words_ = new_words;
+}
+
+int StationRegistry::popcount(const std::vector<uint64_t>& rows, int id) const {
+    size_t row = static_cast<size_t>(id) * slot_words_;
+    if (id < 0 || row >= rows.size()) {
+        return 0;
+    }
+    int count = 0;
+    for (int w = 0; w < slot_words_; w++) {
+        count += __builtin_popcountll(rows[row + w]);
+    }
+    return count;
+}
+
+void StationRegistry::refreshReady(Handle handle, const Dish* dish) const {
+    if (dish == nullptr) {
+        return;
+    }
+    // AND of the station's bit across the recipe's stock rows
+    bool ready = true;
+    for (const Ingredient& ingredient : dish->getIngredients()) {
+        if (!testBit(stocked_, ingredient.id, handle)) {
+            ready = false;
+            break;
+        }
+    }
+    setBit(ready_, dish->getNameId(), handle, ready);
+}
+
+void StationRegistry::refreshIfRecipesChanged(int dish_id) const {
+    if (dish_id < 0) {
+        return;
+    }
+    uint64_t version = Dish::recipeVersion();
+    if (dish_id >= static_cast<int>(ready_versions_.size())) {
+        ready_versions_.resize(dish_id + 1, 0);
+    }
+    if (ready_versions_[dish_id] == version) {
+        return;
+    }
+    ready_versions_[dish_id] = version;
+    // a carrier's copy of the dish may have a new recipe; the ready bits of its other dishes are
+    // refreshed when those dishes are routed
+    for (Handle handle : order_) {
+        if (testBit(capability_, dish_id, handle)) {
+            refreshReady(handle, stations_[handle]->findDish(dish_id));
+        }
+    }
+}
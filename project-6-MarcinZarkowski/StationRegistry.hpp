@@ -0,0 +1,118 @@
+// Contiguous registry of kitchen stations. Each station gets a stable handle (a slot number), and the
+// station pointers are kept in an array indexed by that handle. What the stations carry and stock is kept
+// as bitsets over the slots: one capability bitset per dish ID (bit set = that station carries the dish)
+// and one per ingredient ID (bit set = that station has it in stock). A third bitset per dish ID marks
+// the carriers that have every ingredient of their recipe in stock; it is the AND of the recipe's stock
+// rows. It is refreshed when a station's stock gains or loses an entry, and, before a dish is routed,
+// for every carrier of the dish if some recipe has changed since (Dish::recipeVersion()), e.g. through
+// a dietary accommodation. Routing a dish then reads one row front to back instead of chasing
+// Node -> KitchenStation -> vector pointers. Stock quantities are mirrored the same way, one row of
+// ints per ingredient ID, so a recipe can be checked against every station with contiguous vector loads.
+//
+// The registry is intrusive: a registered station keeps its handle and reports its own changes
+// (dish assigned, ingredient stocked or used up), so the arrays never go stale.
+
+#ifndef STATIONREGISTRY_HPP
+#define STATIONREGISTRY_HPP
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+class KitchenStation;
+class Dish;
+
+class StationRegistry {
+public:
+    using Handle = int;
+    // handle of a station that is not in a registry
+    static constexpr Handle NO_HANDLE = -1;
+
+    StationRegistry();
+
+    /**
+     * Destructor.
+     * @post: Every station still registered is detached; the stations themselves are not deleted.
+     */
+    ~StationRegistry();
+
+    StationRegistry(const StationRegistry&) = delete;
+    StationRegistry& operator=(const StationRegistry&) = delete;
+
+    /**
+     * Registers a station at the back of the list order.
+     * @param station A pointer to the station.
+     * @pre: The station is not in any registry.
+     * @post: The station's hot fields are copied in and the station reports its changes to this registry.
+     * @return: The station's handle, which stays the same until the station is removed.
+     */
+    Handle add(KitchenStation* station);
+
+    /**
+     * @param station A pointer to a registered station.
+     * @post: The station is detached and its slot is free for reuse.
+     * @return: True if the station was in this registry; false otherwise.
+     */
+    bool remove(KitchenStation* station);
+
+    /**
+     * @param station A pointer to a registered station.
+     * @post: The station comes first in the list order; the others keep their order.
+     * @return: True if the station was in this registry; false otherwise.
+     */
+    bool moveToFront(KitchenStation* station);
+
+    /**
+     * Checks a dish against every station at once: starting from the ready stations, each recipe
+     * ingredient's quantity row is compared against the required quantity (StockKernel::coverRow).
+     * Stations whose copy of the dish has a different recipe are checked on their own.
+     * @param dish_id The dish's interned name (Dish::getNameId()).
+     * @return: The stations that can complete the dish right now, in list order.
+     */
+    std::vector<KitchenStation*> ableToComplete(int dish_id) const;
+
+    // Hooks a registered KitchenStation calls when its hot fields change.
+    void dishAssigned(Handle handle, int dish_id);
+    // quantity is StockKernel::NOT_STOCKED once the ingredient's entry is removed
+    void stockChanged(Handle handle, int ingredient_id, int quantity);
+
+private:
+    static const int WORD_BITS = 64;
+
+    // sets or clears the bit for `slot` in row `id` of a bitset table, adding rows as needed
+    void setBit(std::vector<uint64_t>& rows, int id, int slot, bool value) const;
+    bool testBit(const std::vector<uint64_t>& rows, int id, int slot) const;
+    // sets a cell of quantities_, adding rows as needed
+    void setQuantity(int ingredient_id, int slot, int quantity);
+    // widens every row of all tables so `slot` fits
+    void fitSlot(int slot);
+    int popcount(const std::vector<uint64_t>& rows, int id) const;
+    // recomputes a station's ready bit for one of its dishes from the stock rows
+    void refreshReady(Handle handle, const Dish* dish) const;
+    // recomputes the ready bits of every carrier of a dish if any recipe has changed since they were
+    // last brought up to date
+    void refreshIfRecipesChanged(int dish_id) const;
+
+    // the arrays below are indexed by handle
+    std::vector<KitchenStation*> stations_; // nullptr for a free slot
+
+    // bitsets over the slots, slot_words_ words per row
+    std::vector<uint64_t> capability_; // row per dish ID: the stations that carry it
+    std::vector<uint64_t> stocked_;    // row per ingredient ID: the stations that have it in stock
+    // row per dish ID: the carriers with the whole recipe in stock. Brought up to date lazily when a
+    // recipe changes, hence mutable
+    mutable std::vector<uint64_t> ready_;
+    mutable std::vector<uint64_t> ready_versions_; // per dish ID: Dish::recipeVersion() its row was last refreshed at
+    int slot_words_;
+
+    // row per ingredient ID, slot_words_ * WORD_BITS quantities per row (StockKernel::NOT_STOCKED if none)
+    std::vector<int> quantities_;
+
+    std::vector<Handle> order_;      // handles in list order, front first
+    std::vector<Handle> free_slots_; // slots of removed stations, reused by add()
+
+    // stations report changes from their own worker threads during processAllDishesParallel
+    mutable std::mutex mutex_;
+};
+
+#endif // STATIONREGISTRY_HPP
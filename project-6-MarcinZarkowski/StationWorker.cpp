@@ -0,0 +1,42 @@
+#include "StationWorker.hpp"
+
+StationWorker::StationWorker(KitchenStation* station)
+    : station_(station), stopping_(false), thread_(&StationWorker::run, this) {
+}
+
+StationWorker::~StationWorker() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    ready_.notify_one();
+    thread_.join();
+}
+
+KitchenStation* StationWorker::getStation() const {
+    return station_;
+}
+
+void StationWorker::post(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        inbox_.push(std::move(task));
+    }
+    ready_.notify_one();
+}
+
+void StationWorker::run() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            ready_.wait(lock, [this] { return stopping_ || !inbox_.empty(); });
+            if (inbox_.empty()) {
+                return; // stopping and nothing left to do
+            }
+            task = std::move(inbox_.front());
+            inbox_.pop();
+        }
+        task();
+    }
+}
@@ -0,0 +1,56 @@
+// Worker thread bound to a single kitchen station. StationManager::processAllDishesParallel gives every
+// station one of these, so all work on a station's stock happens on that station's own thread.
+
+#ifndef STATIONWORKER_HPP
+#define STATIONWORKER_HPP
+
+#include "KitchenStation.hpp"
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+class StationWorker {
+public:
+    /**
+     * Starts a worker thread for a station.
+     * @param station A pointer to the station this worker prepares dishes for.
+     * @post: The thread is running and waiting for tasks.
+     */
+    explicit StationWorker(KitchenStation* station);
+
+    /**
+     * Destructor.
+     * @post: Runs every task still in the inbound queue, then stops and joins the thread.
+     */
+    ~StationWorker();
+
+    StationWorker(const StationWorker&) = delete;
+    StationWorker& operator=(const StationWorker&) = delete;
+
+    /**
+     * @return: The station this worker prepares dishes for.
+     */
+    KitchenStation* getStation() const;
+
+    /**
+     * Adds a task to the end of the worker's inbound queue.
+     * @param task The work to run on the worker thread.
+     * @post: The task runs on the worker thread after every task posted before it.
+     */
+    void post(std::function<void()> task);
+
+private:
+    // thread body, runs tasks until stopping_ is set and the inbound queue is empty
+    void run();
+
+    KitchenStation* station_;
+    std::queue<std::function<void()>> inbox_;
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    bool stopping_;
+    std::thread thread_; // declared last so it starts after everything it uses
+};
+
+#endif // STATIONWORKER_HPP
@@ -0,0 +1,121 @@
+#include "StockKernel.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define STOCK_KERNEL_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// a lane passes when the ingredient is stocked with at least the required quantity
+inline bool enough(int quantity, int required) {
+    return quantity != StockKernel::NOT_STOCKED && quantity >= required;
+}
+
+bool coversScalar(const int* stock, int stock_size, const int* ids, const int* required, int first, int count) {
+    for (int i = first; i < count; i++) {
+        int quantity = (ids[i] >= 0 && ids[i] < stock_size) ? stock[ids[i]] : StockKernel::NOT_STOCKED;
+        if (!enough(quantity, required[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#ifndef STOCK_KERNEL_X86
+
+uint64_t coverWordScalar(const int* quantities, int required) {
+    uint64_t pass = 0;
+    for (int lane = 0; lane < 64; lane++) {
+        pass |= uint64_t(enough(quantities[lane], required)) << lane;
+    }
+    return pass;
+}
+
+#else
+
+__attribute__((target("avx2")))
+bool coversAvx2(const int* stock, int stock_size, const int* ids, const int* required, int count) {
+    const __m256i missing = _mm256_set1_epi32(StockKernel::NOT_STOCKED);
+    const __m256i size = _mm256_set1_epi32(stock_size);
+    const __m256i minus_one = _mm256_set1_epi32(-1);
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i id = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ids + i));
+        __m256i need = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(required + i));
+        // only gather lanes whose ID is inside the stock array; the rest read as NOT_STOCKED
+        __m256i in_range = _mm256_and_si256(_mm256_cmpgt_epi32(id, minus_one), _mm256_cmpgt_epi32(size, id));
+        __m256i quantity = _mm256_mask_i32gather_epi32(missing, stock, id, in_range, 4);
+        __m256i fail = _mm256_or_si256(_mm256_cmpeq_epi32(quantity, missing), _mm256_cmpgt_epi32(need, quantity));
+        if (!_mm256_testz_si256(fail, fail)) {
+            return false;
+        }
+    }
+    return coversScalar(stock, stock_size, ids, required, i, count);
+}
+
+__attribute__((target("avx2")))
+uint64_t coverWordAvx2(const int* quantities, int required) {
+    const __m256i missing = _mm256_set1_epi32(StockKernel::NOT_STOCKED);
+    const __m256i need = _mm256_set1_epi32(required);
+    uint64_t pass = 0;
+    for (int lane = 0; lane < 64; lane += 8) {
+        __m256i quantity = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(quantities + lane));
+        __m256i fail = _mm256_or_si256(_mm256_cmpeq_epi32(quantity, missing), _mm256_cmpgt_epi32(need, quantity));
+        uint64_t failed = static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(fail)));
+        pass |= (~failed & 0xFF) << lane;
+    }
+    return pass;
+}
+
+// SSE2 is part of x86-64, so this needs no runtime check there
+__attribute__((target("sse2")))
+uint64_t coverWordSse2(const int* quantities, int required) {
+    const __m128i missing = _mm_set1_epi32(StockKernel::NOT_STOCKED);
+    const __m128i need = _mm_set1_epi32(required);
+    uint64_t pass = 0;
+    for (int lane = 0; lane < 64; lane += 4) {
+        __m128i quantity = _mm_loadu_si128(reinterpret_cast<const __m128i*>(quantities + lane));
+        __m128i fail = _mm_or_si128(_mm_cmpeq_epi32(quantity, missing), _mm_cmpgt_epi32(need, quantity));
+        uint64_t failed = static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(fail)));
+        pass |= (~failed & 0xF) << lane;
+    }
+    return pass;
+}
+
+#endif // STOCK_KERNEL_X86
+
+} // namespace
+
+bool StockKernel::hasAvx2() {
+#ifdef STOCK_KERNEL_X86
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    return avx2;
+#else
+    return false;
+#endif
+}
+
+bool StockKernel::covers(const int* stock, int stock_size, const int* ids, const int* required, int count) {
+#ifdef STOCK_KERNEL_X86
+    // a gather only pays off once there is a full vector of ingredients
+    if (count >= 8 && hasAvx2()) {
+        return coversAvx2(stock, stock_size, ids, required, count);
+    }
+#endif
+    return coversScalar(stock, stock_size, ids, required, 0, count);
+}
+
+void StockKernel::coverRow(const int* quantities, int word_count, int required, uint64_t* mask) {
+    for (int w = 0; w < word_count; w++) {
+        if (mask[w] == 0) {
+            continue; // every station in this word is already ruled out
+        }
+        const int* word_quantities = quantities + w * 64;
+#ifdef STOCK_KERNEL_X86
+        mask[w] &= hasAvx2() ? coverWordAvx2(word_quantities, required) : coverWordSse2(word_quantities, required);
+#else
+        mask[w] &= coverWordScalar(word_quantities, required);
+#endif
+    }
+}
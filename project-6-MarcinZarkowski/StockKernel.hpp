@@ -0,0 +1,45 @@
+#ifndef STOCKKERNEL_HPP
+#define STOCKKERNEL_HPP
+
+#include <climits>
+#include <cstdint>
+
+/**
+ * Vectorized checks of recipes against dense stock arrays.
+ * Stock is kept as one int per interned ingredient ID holding the quantity in stock,
+ * or NOT_STOCKED when the ingredient has no entry at all. A recipe is the list of its
+ * ingredient IDs and, in the same order, the quantity each one requires.
+ * On x86 the checks run 8 lanes at a time with AVX2 when the CPU has it (4 lanes with
+ * SSE2 otherwise); anywhere else they fall back to plain loops. Every path gives the
+ * same answers.
+ */
+class StockKernel {
+public:
+    static constexpr int NOT_STOCKED = INT_MIN;
+
+    /**
+     * Checks a whole recipe against one station's stock: gathers the stock quantity of every
+     * recipe ingredient and compares it against the required quantity.
+     * @param stock Quantities indexed by ingredient ID.
+     * @param stock_size The number of entries in stock; IDs outside [0, stock_size) are not stocked.
+     * @param ids The recipe's ingredient IDs.
+     * @param required The quantity required of each ingredient in ids.
+     * @param count The number of recipe ingredients.
+     * @return: True if every ingredient is stocked with at least the required quantity.
+     */
+    static bool covers(const int* stock, int stock_size, const int* ids, const int* required, int count);
+
+    /**
+     * Checks one ingredient of a recipe against many stations at once.
+     * @param quantities The ingredient's quantity at each station slot (NOT_STOCKED if it has none).
+     * @param word_count The number of 64-slot words in mask; quantities holds word_count * 64 entries.
+     * @param required The quantity the recipe requires.
+     * @param mask One bit per slot. Bits of slots that do not have the required quantity are cleared.
+     */
+    static void coverRow(const int* quantities, int word_count, int required, uint64_t* mask);
+
+private:
+    static bool hasAvx2();
+};
+
+#endif // STOCKKERNEL_HPP
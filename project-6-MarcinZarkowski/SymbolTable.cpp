@@ -0,0 +1,60 @@
+#include "SymbolTable.hpp"
+
+int SymbolTable::intern(const std::string& name) {
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = ids_.find(name);
+        if (it != ids_.end()) {
+            return it->second;
+        }
+    }
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto it = ids_.find(name); // another thread may have added it in between
+    if (it != ids_.end()) {
+        return it->second;
+    }
+    int id = static_cast<int>(names_.size());
+    it = ids_.emplace(name, id).first;
+    names_.push_back(&it->first);
+    return id;
+}
+
+std::vector<int> SymbolTable::internAll(std::initializer_list<const char*> names) {
+    std::vector<int> ids;
+    ids.reserve(names.size());
+    for (const char* name : names) {
+        ids.push_back(intern(name));
+    }
+    return ids;
+}
+
+int SymbolTable::lookup(const std::string& name) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = ids_.find(name);
+    return (it == ids_.end()) ? NO_ID : it->second;
+}
+
+const std::string& SymbolTable::nameOf(int id) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return *names_[id];
+}
+
+int SymbolTable::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return static_cast<int>(names_.size());
+}
+
+SymbolTable& SymbolTable::ingredients() {
+    static SymbolTable table;
+    return table;
+}
+
+SymbolTable& SymbolTable::dishes() {
+    static SymbolTable table;
+    return table;
+}
+
+SymbolTable& SymbolTable::stations() {
+    static SymbolTable table;
+    return table;
+}
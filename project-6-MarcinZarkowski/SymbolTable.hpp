@@ -0,0 +1,75 @@
+#ifndef SYMBOLTABLE_HPP
+#define SYMBOLTABLE_HPP
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <initializer_list>
+#include <mutex>
+#include <shared_mutex>
+
+/**
+ * Interns names into compact integer IDs.
+ * The same name always maps to the same ID, and IDs are handed out densely from 0,
+ * so they can be compared directly or used as indexes into vectors.
+ * There is one global table each for ingredient, dish and station names.
+ * All member functions are safe to call from several threads at once.
+ */
+class SymbolTable {
+public:
+    // ID returned by lookup() for a name that has never been interned
+    static constexpr int NO_ID = -1;
+
+    /**
+     * @param name The name to intern.
+     * @post If the name is new, it is assigned the next free ID.
+     * @return The ID of the name.
+     */
+    int intern(const std::string& name);
+
+    /**
+     * Interns every name in the list.
+     * @param names The names to intern.
+     * @return The IDs of the names, in the same order.
+     */
+    std::vector<int> internAll(std::initializer_list<const char*> names);
+
+    /**
+     * @param name The name to look up.
+     * @return The ID of the name, or NO_ID if it was never interned. Never adds the name.
+     */
+    int lookup(const std::string& name) const;
+
+    /**
+     * @param id An ID returned by intern().
+     * @return The name the ID was assigned to.
+     */
+    const std::string& nameOf(int id) const;
+
+    /**
+     * @return The number of interned names, which is one more than the largest ID.
+     */
+    int size() const;
+
+    /**
+     * @return The global table of ingredient names.
+     */
+    static SymbolTable& ingredients();
+
+    /**
+     * @return The global table of dish names.
+     */
+    static SymbolTable& dishes();
+
+    /**
+     * @return The global table of station names.
+     */
+    static SymbolTable& stations();
+
+private:
+    std::unordered_map<std::string, int> ids_;
+    std::vector<const std::string*> names_; // points at the keys of ids_, which never move
+    mutable std::shared_mutex mutex_;       // shared for reads, exclusive while adding a name
+};
+
+#endif // SYMBOLTABLE_HPP
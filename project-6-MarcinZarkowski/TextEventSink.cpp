@@ -0,0 +1,69 @@
+#include "TextEventSink.hpp"
+#include "SymbolTable.hpp"
+
+TextEventSink::TextEventSink(std::ostream& out, size_t buffer_size)
+    : out_(out), buffer_size_(buffer_size) {
+    buffer_.reserve(buffer_size_);
+}
+
+TextEventSink::~TextEventSink() {
+    flush();
+}
+
+void TextEventSink::emit(const Event& event) {
+    const std::string* dish = nullptr;
+    const std::string* station = nullptr;
+    if (event.dish_id != SymbolTable::NO_ID) {
+        dish = &SymbolTable::dishes().nameOf(event.dish_id);
+    }
+    if (event.station_id != SymbolTable::NO_ID) {
+        station = &SymbolTable::stations().nameOf(event.station_id);
+    }
+
+    switch (event.type) {
+        case EventType::DISH_STARTED:
+            buffer_.append("PREPARING DISH: ").append(*dish).append("\n");
+            break;
+        case EventType::ATTEMPTING:
+            buffer_.append(*station).append(" attempting to prepare ").append(*dish).append("...\n");
+            break;
+        case EventType::NOT_CARRIED:
+            buffer_.append(*station).append(": Dish not available. Moving to next station...\n");
+            break;
+        case EventType::INSUFFICIENT_STOCK:
+            buffer_.append(*station).append(": Insufficient ingredients. Replenishing ingredients...\n");
+            break;
+        case EventType::REPLENISHED:
+            buffer_.append(*station).append(": Ingredients replenished.\n");
+            break;
+        case EventType::REPLENISH_FAILED:
+            buffer_.append(*station).append(": Unable to replenish ingredients. Failed to prepare ").append(*dish).append(".\n");
+            break;
+        case EventType::PREPARED:
+            buffer_.append(*station).append(": Successfully prepared ").append(*dish).append(".\n");
+            break;
+        case EventType::DISH_PREPARED:
+            buffer_.append("\n");
+            break;
+        case EventType::DISH_NOT_PREPARED:
+            buffer_.append(*dish).append(" was not prepared.\n\n");
+            break;
+        case EventType::ALL_PROCESSED:
+            buffer_.append("\nAll dishes have been processed.\n");
+            break;
+    }
+
+    if (buffer_.size() >= buffer_size_) {
+        writeBuffer();
+    }
+}
+
+void TextEventSink::flush() {
+    writeBuffer();
+    out_.flush();
+}
+
+void TextEventSink::writeBuffer() {
+    out_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    buffer_.clear();
+}
@@ -0,0 +1,53 @@
+// Event sink that formats events into the human-readable kitchen log ("PREPARING DISH: ...",
+// "<station>: Ingredients replenished.", ...). Lines are collected in a buffer and written to the
+// stream in large blocks, and the stream is only flushed by flush(), not after every line.
+
+#ifndef TEXTEVENTSINK_HPP
+#define TEXTEVENTSINK_HPP
+
+#include "KitchenEventSink.hpp"
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+class TextEventSink : public KitchenEventSink {
+public:
+    // the buffer is written to the stream once it holds this many bytes
+    static const size_t DEFAULT_BUFFER_SIZE = 64 * 1024;
+
+    /**
+     * @param out The stream the lines are written to. It must outlive the sink.
+     * @param buffer_size The number of bytes collected before they are written to the stream.
+     */
+    explicit TextEventSink(std::ostream& out, size_t buffer_size = DEFAULT_BUFFER_SIZE);
+
+    /**
+     * Destructor.
+     * @post: The buffered lines are flushed to the stream.
+     */
+    ~TextEventSink() override;
+
+    TextEventSink(const TextEventSink&) = delete;
+    TextEventSink& operator=(const TextEventSink&) = delete;
+
+    /**
+     * @param event The event to format.
+     * @post: The event's line (if it has one) is appended to the buffer, and the buffer is written to
+     * the stream if it is full.
+     */
+    void emit(const Event& event) override;
+
+    /**
+     * @post: The buffered lines are written to the stream and the stream is flushed.
+     */
+    void flush() override;
+
+private:
+    void writeBuffer();
+
+    std::ostream& out_;
+    std::string buffer_;
+    size_t buffer_size_;
+};
+
+#endif // TEXTEVENTSINK_HPP
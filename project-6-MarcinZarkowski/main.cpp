@@ -1,7 +1,11 @@
 #include "StationManager.hpp"
 #include "Appetizer.hpp"
+#include "DishArena.hpp"
 
 int main() {
+    // Owns every dish made during this shift; declared first so it outlives the stations and queue
+    DishArena shift;
+
     // Initialize Station Manager and Stations
     StationManager* stationManager = new StationManager();
     KitchenStation* station1 = new KitchenStation("Station1");
@@ -36,9 +40,9 @@ int main() {
     stationManager->addBackupIngredient(tomato);
 
     // Create dishes
-    Dish* pizza = new Appetizer("Pizza", {cheese, bread}, 10, 9.99, Dish::CuisineType::ITALIAN, Appetizer::ServingStyle::PLATED, 4, false);
-    Dish* burger = new Appetizer("Burger", {bread, meat}, 8, 7.49, Dish::CuisineType::AMERICAN, Appetizer::ServingStyle::PLATED, 3, false);
-    Dish* salad = new Appetizer("Salad", {tomato}, 6, 5.99, Dish::CuisineType::ITALIAN, Appetizer::ServingStyle::PLATED, 2, true);
+    Dish* pizza = shift.make<Appetizer>("Pizza", std::vector<Ingredient>{cheese, bread}, 10, 9.99, Dish::CuisineType::ITALIAN, Appetizer::ServingStyle::PLATED, 4, false);
+    Dish* burger = shift.make<Appetizer>("Burger", std::vector<Ingredient>{bread, meat}, 8, 7.49, Dish::CuisineType::AMERICAN, Appetizer::ServingStyle::PLATED, 3, false);
+    Dish* salad = shift.make<Appetizer>("Salad", std::vector<Ingredient>{tomato}, 6, 5.99, Dish::CuisineType::ITALIAN, Appetizer::ServingStyle::PLATED, 2, true);
 
     // Assign dishes to stations
     station1->assignDishToStation(pizza);
@@ -62,10 +66,7 @@ int main() {
     std::cout << "\nDish Queue After Processing:" << std::endl;
     stationManager->displayDishQueue();
 
-    // Cleanup
-    delete pizza;
-    delete burger;
-    delete salad;
+    // Cleanup (the dishes belong to the shift and are released when it ends)
     delete station1;
     delete station2;
     delete stationManager;
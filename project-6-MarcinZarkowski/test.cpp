@@ -0,0 +1,1101 @@
+// Behaviour tests for the station manager and the containers under it. Each test builds a small kitchen
+// or container, runs one path and checks the state it leaves behind, failures and rollbacks included.
+// Build and run with `make check`: every failed check is printed and the program exits non-zero if there
+// was one.
+
+#include "StationManager.hpp"
+#include "StationWorker.hpp"
+#include "Appetizer.hpp"
+#include "DishArena.hpp"
+#include "NullEventSink.hpp"
+#include "RingLogEventSink.hpp"
+#include "MpmcQueue.hpp"
+#include "BackupInventory.hpp"
+#include "LinkedList.hpp"
+#include "NodePool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <iterator>
+#include <queue>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cout << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+Dish* makeDish(DishArena& dishes, const std::string& name, const std::vector<Ingredient>& recipe) {
+    return dishes.make<Appetizer>(name, recipe, 10, 9.99, Dish::CuisineType::OTHER, Appetizer::ServingStyle::PLATED, 0, false);
+}
+
+// quantity of an ingredient in a station's stock, 0 if not stocked
+int stockOf(const KitchenStation& station, const std::string& ingredient_name) {
+    return station.getStockQuantity(SymbolTable::ingredients().lookup(ingredient_name));
+}
+
+// The grill makes burgers, the oven makes pizza and calzones. The manager reports to a NullEventSink.
+struct TestKitchen {
+    DishArena dishes; // outlives the stations and the manager
+    StationManager manager;
+    KitchenStation grill{"Grill"};
+    KitchenStation oven{"Oven"};
+    NullEventSink quiet;
+    Dish* burger;
+    Dish* pizza;
+    Dish* calzone;
+
+    TestKitchen() {
+        burger = makeDish(dishes, "Burger", {Ingredient("beef", 0, 2, 1.0), Ingredient("bun", 0, 1, 0.5)});
+        pizza = makeDish(dishes, "Pizza", {Ingredient("dough", 0, 2, 0.5), Ingredient("cheese", 0, 2, 1.0)});
+        calzone = makeDish(dishes, "Calzone", {Ingredient("dough", 0, 3, 0.5), Ingredient("cheese", 0, 3, 1.0)});
+        grill.assignDishToStation(burger);
+        oven.assignDishToStation(pizza);
+        oven.assignDishToStation(calzone);
+        manager.addStation(&grill);
+        manager.addStation(&oven);
+        manager.setEventSink(&quiet);
+    }
+
+    void stock(KitchenStation& station, const std::string& ingredient_name, int quantity) {
+        station.replenishStationIngredients(Ingredient(ingredient_name, quantity, 0, 1.0));
+    }
+
+    std::vector<Dish*> queue() const {
+        std::vector<Dish*> dishes_left;
+        for (std::queue<Dish*> dish_queue = manager.getDishQueue(); !dish_queue.empty(); dish_queue.pop()) {
+            dishes_left.push_back(dish_queue.front());
+        }
+        return dishes_left;
+    }
+};
+
+// posted tasks run on the worker's own thread in order, and the destructor runs the ones still queued
+void testStationWorkerRunsTasksInOrder() {
+    KitchenStation station("Prep");
+    std::vector<int> ran;
+    std::vector<std::thread::id> threads;
+    {
+        StationWorker worker(&station);
+        check(worker.getStation() == &station, "StationWorker: getStation");
+        for (int i = 0; i < 1000; i++) {
+            worker.post([&ran, &threads, i]() {
+                ran.push_back(i);
+                threads.push_back(std::this_thread::get_id());
+            });
+        }
+    }
+    bool in_order = ran.size() == 1000;
+    for (size_t i = 0; in_order && i < ran.size(); i++) {
+        in_order = ran[i] == static_cast<int>(i) && threads[i] == threads[0];
+    }
+    check(in_order, "StationWorker: every task runs once, in order, on one thread");
+    check(!threads.empty() && threads[0] != std::this_thread::get_id(), "StationWorker: tasks run off the caller's thread");
+}
+
+// burgers x3, pizza x3, calzone: the third pizza needs the backup cheese and the calzone can't be made
+void runSmallShift(TestKitchen& kitchen, int mode) {
+    kitchen.stock(kitchen.grill, "beef", 10);
+    kitchen.stock(kitchen.grill, "bun", 10);
+    kitchen.stock(kitchen.oven, "dough", 6);
+    kitchen.stock(kitchen.oven, "cheese", 4);
+    kitchen.manager.addBackupIngredient(Ingredient("cheese", 2, 0, 1.0));
+    for (Dish* dish : {kitchen.burger, kitchen.pizza, kitchen.burger, kitchen.pizza, kitchen.burger, kitchen.pizza, kitchen.calzone}) {
+        kitchen.manager.addDishToQueue(dish);
+    }
+    if (mode == 0) {
+        kitchen.manager.processAllDishes();
+    } else {
+        kitchen.manager.processAllDishesParallel(mode == 1);
+    }
+}
+
+// both parallel modes leave the same stock, backup and queue as processAllDishes
+void testParallelMatchesSerial() {
+    const char* names[] = {"processAllDishes", "processAllDishesParallel(deterministic)", "processAllDishesParallel"};
+    for (int mode = 0; mode < 3; mode++) {
+        TestKitchen kitchen;
+        runSmallShift(kitchen, mode);
+        std::string name = names[mode];
+        check(stockOf(kitchen.grill, "beef") == 4 && stockOf(kitchen.grill, "bun") == 7, name + ": grill stock");
+        check(!kitchen.oven.isStocked(SymbolTable::ingredients().lookup("dough")) &&
+              !kitchen.oven.isStocked(SymbolTable::ingredients().lookup("cheese")), name + ": used-up oven stock is removed");
+        check(kitchen.manager.getBackupIngredients().empty(), name + ": backup cheese is drawn");
+        check(kitchen.queue() == std::vector<Dish*>{kitchen.calzone}, name + ": only the calzone stays queued");
+    }
+}
+
+// with stock for only some of many dishes, each station still prepares its dishes in queue order and the
+// rest stay queued in their original order. Every queued dish is its own object, as processAllDishes
+// stops once the first dish it put back comes round again.
+void testParallelKeepsUnpreparedInOrder() {
+    for (bool deterministic : {true, false}) {
+        TestKitchen kitchen;
+        kitchen.stock(kitchen.grill, "beef", 100);
+        kitchen.stock(kitchen.grill, "bun", 1000);
+        kitchen.stock(kitchen.oven, "dough", 1000);
+        kitchen.stock(kitchen.oven, "cheese", 60);
+        std::vector<Dish*> queued;
+        for (int i = 0; i < 200; i++) {
+            queued.push_back((i % 3 == 0) ? makeDish(kitchen.dishes, "Pizza", kitchen.pizza->getIngredients())
+                                          : makeDish(kitchen.dishes, "Burger", kitchen.burger->getIngredients()));
+        }
+        kitchen.manager.addDishesToQueue(queued);
+        kitchen.manager.processAllDishesParallel(deterministic);
+
+        // 50 burgers and 30 pizzas fit in the stock; they are the first of each in the queue
+        std::vector<Dish*> expected;
+        int burgers = 0, pizzas = 0;
+        for (Dish* dish : queued) {
+            bool is_pizza = dish->getName() == "Pizza";
+            if ((is_pizza ? pizzas++ : burgers++) >= (is_pizza ? 30 : 50)) {
+                expected.push_back(dish);
+            }
+        }
+        std::string name = deterministic ? "processAllDishesParallel(deterministic)" : "processAllDishesParallel";
+        check(kitchen.queue() == expected, name + ": unprepared dishes stay in queue order");
+        check(stockOf(kitchen.grill, "bun") == 950 && stockOf(kitchen.oven, "dough") == 940, name + ": stock deducted once per dish");
+    }
+}
+
+// whether the dishes of `part`, in order, appear in that order within `whole`
+bool keepsOrder(const std::vector<Dish*>& whole, const std::vector<Dish*>& part) {
+    size_t next = 0;
+    for (Dish* dish : whole) {
+        if (next < part.size() && dish == part[next]) {
+            next++;
+        }
+    }
+    return next == part.size();
+}
+
+// a batch push stops when the ring is full, a batch pop takes what is there, and both keep FIFO order
+void testMpmcQueueBatches() {
+    MpmcQueue<int> queue(5);
+    check(queue.capacity() == 8, "MpmcQueue: capacity rounds up to a power of two");
+    int first[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    check(queue.tryPushBatch(first, 10) == 8, "MpmcQueue: tryPushBatch stops when full");
+    check(!queue.tryPush(99), "MpmcQueue: tryPush fails when full");
+
+    std::vector<int> out;
+    check(queue.tryPopBatch(out, 0) == 0 && out.empty() && !queue.isEmpty(), "MpmcQueue: a zero-size tryPopBatch takes nothing");
+    check(queue.tryPushBatch(first, 0) == 0, "MpmcQueue: a zero-size tryPushBatch adds nothing");
+    check(queue.tryPopBatch(out, 5) == 5 && out == std::vector<int>{0, 1, 2, 3, 4}, "MpmcQueue: tryPopBatch takes the front");
+    int second[5] = {100, 101, 102, 103, 104};
+    check(queue.tryPushBatch(second, 5) == 5, "MpmcQueue: tryPushBatch wraps round the ring");
+
+    std::vector<int> seen;
+    queue.forEach([&seen](int item) { seen.push_back(item); });
+    check(seen == std::vector<int>{5, 6, 7, 100, 101, 102, 103, 104}, "MpmcQueue: forEach visits front to back");
+
+    out.clear();
+    check(queue.tryPopBatch(out, 100) == 8 && out == seen, "MpmcQueue: tryPopBatch takes no more than there is");
+    int item;
+    check(!queue.tryPop(item) && queue.isEmpty() && queue.tryPopBatch(out, 4) == 0, "MpmcQueue: empty after draining");
+}
+
+// producers mixing single and batch pushes against a small ring: every item comes out exactly once, and
+// a single consumer sees each producer's items in the order they were pushed
+void testMpmcQueueConcurrent() {
+    const int PRODUCERS = 4;
+    const int PER_PRODUCER = 20000;
+    for (int consumers : {1, 2}) {
+        MpmcQueue<int> queue(64);
+        std::atomic<int> popped(0);
+        std::vector<std::vector<int>> received(consumers);
+        std::vector<std::thread> threads;
+        for (int p = 0; p < PRODUCERS; p++) {
+            threads.emplace_back([&queue, p]() {
+                int batch[7];
+                for (int i = 0; i < PER_PRODUCER; ) {
+                    if (i % 2 == 0) {
+                        int count = std::min(7, PER_PRODUCER - i);
+                        for (int k = 0; k < count; k++) {
+                            batch[k] = p * PER_PRODUCER + i + k;
+                        }
+                        i += static_cast<int>(queue.tryPushBatch(batch, count));
+                    } else if (queue.tryPush(p * PER_PRODUCER + i)) {
+                        i++;
+                    }
+                    std::this_thread::yield();
+                }
+            });
+        }
+        for (int c = 0; c < consumers; c++) {
+            threads.emplace_back([&queue, &popped, &received, c]() {
+                std::vector<int>& mine = received[c];
+                while (popped.load() < PRODUCERS * PER_PRODUCER) {
+                    size_t before = mine.size();
+                    popped += static_cast<int>(queue.tryPopBatch(mine, 16));
+                    int item;
+                    if (mine.size() == before && queue.tryPop(item)) {
+                        mine.push_back(item);
+                        popped++;
+                    } else if (mine.size() == before) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        std::vector<int> count(PRODUCERS * PER_PRODUCER, 0);
+        bool in_order = true;
+        for (const std::vector<int>& mine : received) {
+            std::vector<int> last(PRODUCERS, -1);
+            for (int item : mine) {
+                count[item]++;
+                in_order = in_order && item > last[item / PER_PRODUCER];
+                last[item / PER_PRODUCER] = item;
+            }
+        }
+        std::string name = "MpmcQueue with " + std::to_string(consumers) + " consumer(s)";
+        check(std::all_of(count.begin(), count.end(), [](int n) { return n == 1; }), name + ": every item popped exactly once");
+        check(in_order, name + ": each consumer sees a producer's items in push order");
+    }
+}
+
+// once the intake is full, further dishes spill to the overflow list, and the queue still reads and
+// drains in the order the dishes were added
+void testIntakeOverflowKeepsOrder() {
+    TestKitchen kitchen;
+    kitchen.stock(kitchen.grill, "beef", 100);
+    kitchen.stock(kitchen.grill, "bun", 100);
+    kitchen.manager.enableConcurrentQueue(4);
+    std::vector<Dish*> burgers;
+    for (int i = 0; i < 9; i++) {
+        burgers.push_back(makeDish(kitchen.dishes, "Burger", kitchen.burger->getIngredients()));
+    }
+    kitchen.manager.addDishesToQueue(std::vector<Dish*>(burgers.begin(), burgers.begin() + 6));
+    kitchen.manager.addDishToQueue(burgers[6]);
+    check(kitchen.queue() == std::vector<Dish*>(burgers.begin(), burgers.begin() + 7), "intake: overflow is read back in order");
+
+    check(kitchen.manager.prepareNextDish(), "intake: prepareNextDish drains the intake and overflow");
+    kitchen.manager.addDishToQueue(burgers[7]);
+    kitchen.manager.addDishesToQueue({burgers[8]});
+    check(kitchen.queue() == std::vector<Dish*>(burgers.begin() + 1, burgers.end()), "intake: dishes added after a drain queue behind the rest");
+
+    kitchen.manager.processAllDishes();
+    check(kitchen.queue().empty() && stockOf(kitchen.grill, "bun") == 91, "intake: every dish is prepared once");
+}
+
+// producers adding singly and in bursts through a small intake while the kitchen thread reads the queue:
+// nothing is lost and each producer's dishes stay in the order it added them
+void testIntakeConcurrentProducers() {
+    const int PRODUCERS = 4;
+    const int PER_PRODUCER = 250;
+    TestKitchen kitchen;
+    kitchen.manager.enableConcurrentQueue(16);
+    std::vector<std::vector<Dish*>> added(PRODUCERS);
+    for (std::vector<Dish*>& dishes : added) {
+        for (int i = 0; i < PER_PRODUCER; i++) {
+            dishes.push_back(makeDish(kitchen.dishes, "Soup", {}));
+        }
+    }
+
+    std::atomic<int> done(0);
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; p++) {
+        producers.emplace_back([&kitchen, &added, &done, p]() {
+            const std::vector<Dish*>& dishes = added[p];
+            for (int i = 0; i < PER_PRODUCER; ) {
+                if (i % 20 == 0) {
+                    int count = std::min(10, PER_PRODUCER - i);
+                    kitchen.manager.addDishesToQueue(std::vector<Dish*>(dishes.begin() + i, dishes.begin() + i + count));
+                    i += count;
+                } else {
+                    kitchen.manager.addDishToQueue(dishes[i++]);
+                }
+            }
+            done++;
+        });
+    }
+    // the snapshots taken meanwhile may miss dishes still being added, but never reorder a producer's
+    std::unordered_map<Dish*, std::pair<int, int>> added_by; // dish -> (producer, position)
+    for (int p = 0; p < PRODUCERS; p++) {
+        for (int i = 0; i < PER_PRODUCER; i++) {
+            added_by[added[p][i]] = std::make_pair(p, i);
+        }
+    }
+    bool snapshots_in_order = true;
+    while (done.load() < PRODUCERS) {
+        std::vector<int> last(PRODUCERS, -1);
+        for (Dish* dish : kitchen.queue()) {
+            std::pair<int, int> origin = added_by[dish];
+            snapshots_in_order = snapshots_in_order && origin.second > last[origin.first];
+            last[origin.first] = origin.second;
+        }
+        std::this_thread::yield();
+    }
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+
+    std::vector<Dish*> queue = kitchen.queue();
+    bool all_in_order = queue.size() == PRODUCERS * PER_PRODUCER;
+    for (const std::vector<Dish*>& dishes : added) {
+        all_in_order = all_in_order && keepsOrder(queue, dishes);
+    }
+    check(snapshots_in_order, "intake: getDishQueue during concurrent adds keeps each producer's order");
+    check(all_in_order, "intake: concurrent producers lose nothing and keep their own order");
+    kitchen.manager.clearDishQueue();
+    check(kitchen.queue().empty(), "intake: clearDishQueue empties the intake and overflow");
+}
+
+// a dietary accommodation rewrites the recipe a station carries; with or without the registry the
+// manager must see the new recipe, not the ready bits worked out for the old one
+void testRegistrySeesRecipeChanges() {
+    for (bool with_registry : {false, true}) {
+        DishArena dishes;
+        StationManager manager;
+        KitchenStation station("Wok");
+        Dish* dish = makeDish(dishes, "CR", {Ingredient("Chicken", 0, 1, 1.0), Ingredient("Rice", 0, 1, 1.0)});
+        station.assignDishToStation(dish);
+        station.replenishStationIngredients(Ingredient("Beans", 5, 0, 1.0));
+        station.replenishStationIngredients(Ingredient("Rice", 5, 0, 1.0));
+        manager.addStation(&station);
+        if (with_registry) {
+            manager.enableStationRegistry();
+        }
+        std::string name = with_registry ? "registry" : "no registry";
+        check(!manager.canCompleteOrder("CR"), name + ": no chicken, so CR can't be made");
+
+        Dish::DietaryRequest vegetarian = {true, false, false, false, false, false};
+        manager.addDishToQueue(dish, vegetarian);
+        check(station.canCompleteOrder("CR"), name + ": the station can make the vegetarian CR");
+        check(manager.canCompleteOrder("CR"), name + ": the manager agrees with the station after the rewrite");
+        check(manager.prepareNextDish() && stockOf(station, "Beans") == 4, name + ": the vegetarian CR is prepared");
+    }
+}
+
+// the other way round: the rewritten recipe needs an ingredient no station has ever stocked, so the
+// registry has no quantity row for it and the dish can't be made anywhere
+void testRegistryRecipeNeedsUnstockedIngredient() {
+    DishArena dishes;
+    StationManager manager;
+    KitchenStation station("Wok");
+    Dish* dish = makeDish(dishes, "CR", {Ingredient("Chicken", 0, 1, 1.0), Ingredient("Rice", 0, 1, 1.0)});
+    station.assignDishToStation(dish);
+    station.replenishStationIngredients(Ingredient("Chicken", 5, 0, 1.0));
+    station.replenishStationIngredients(Ingredient("Rice", 5, 0, 1.0));
+    manager.addStation(&station);
+    manager.enableStationRegistry();
+    check(manager.canCompleteOrder("CR"), "registry: CR can be made before the rewrite");
+
+    Dish::DietaryRequest vegetarian = {true, false, false, false, false, false};
+    manager.addDishToQueue(dish, vegetarian);
+    check(!station.canCompleteOrder("CR") && !manager.canCompleteOrder("CR"), "registry: no beans anywhere, so the vegetarian CR can't be made");
+    check(!manager.prepareNextDish() && stockOf(station, "Chicken") == 5 && stockOf(station, "Rice") == 5, "registry: nothing is taken for it");
+}
+
+// a pending reservation gives its ingredients back when rolled back or destroyed, and keeps the
+// deduction once committed
+void testReservationCommitAndRollback() {
+    DishArena dishes;
+    KitchenStation station("Line");
+    Dish* burger = makeDish(dishes, "Burger", {Ingredient("beef", 0, 2, 1.0), Ingredient("bun", 0, 1, 0.5)});
+    station.assignDishToStation(burger);
+    station.replenishStationIngredients(Ingredient("beef", 5, 0, 1.0));
+    station.replenishStationIngredients(Ingredient("bun", 1, 0, 0.5));
+    {
+        KitchenStation::Reservation reservation;
+        check(station.reserveIngredients(burger->getNameId(), reservation) && reservation.isPending(), "Reservation: reserve takes the recipe");
+        check(stockOf(station, "beef") == 3 && !station.isStocked(SymbolTable::ingredients().lookup("bun")), "Reservation: the stock is held while pending");
+        reservation.rollback();
+        check(!reservation.isPending() && stockOf(station, "beef") == 5 && stockOf(station, "bun") == 1, "Reservation: rollback puts everything back");
+    }
+    {
+        KitchenStation::Reservation reservation;
+        station.reserveIngredients(burger->getNameId(), reservation);
+    }
+    check(stockOf(station, "beef") == 5 && stockOf(station, "bun") == 1, "Reservation: a pending reservation is rolled back when destroyed");
+    {
+        KitchenStation::Reservation reservation;
+        station.reserveIngredients(burger->getNameId(), reservation);
+        reservation.commit();
+    }
+    check(stockOf(station, "beef") == 3 && stockOf(station, "bun") == 0, "Reservation: commit keeps the deduction");
+
+    KitchenStation::Reservation reservation;
+    check(!station.reserveIngredients(burger->getNameId(), reservation) && !reservation.isPending(), "Reservation: no bun, nothing reserved");
+    check(stockOf(station, "beef") == 3, "Reservation: a failed reserve leaves the stock alone");
+}
+
+// reserving for several dishes takes what the scarcest ingredient allows; a recipe that lists an
+// ingredient twice can pass the per-ingredient check and still run short, and then nothing is taken
+void testReserveSeveralAndShortRecipe() {
+    DishArena dishes;
+    KitchenStation station("Line");
+    Dish* burger = makeDish(dishes, "Burger", {Ingredient("beef", 0, 2, 1.0), Ingredient("bun", 0, 1, 0.5)});
+    Dish* stew = makeDish(dishes, "Stew", {Ingredient("salt", 0, 3, 0.1), Ingredient("pepper", 0, 0, 0.1), Ingredient("salt", 0, 3, 0.1)});
+    station.assignDishToStation(burger);
+    station.assignDishToStation(stew);
+    station.replenishStationIngredients(Ingredient("beef", 9, 0, 1.0));
+    station.replenishStationIngredients(Ingredient("bun", 10, 0, 0.5));
+    station.replenishStationIngredients(Ingredient("salt", 5, 0, 0.1));
+    station.replenishStationIngredients(Ingredient("pepper", 1, 0, 0.1));
+
+    KitchenStation::Reservation several;
+    check(station.reserveIngredients(burger->getNameId(), 10, several) == 4, "reserveIngredients(count): beef for four burgers");
+    check(stockOf(station, "beef") == 1 && stockOf(station, "bun") == 6, "reserveIngredients(count): four recipes taken in one go");
+    several.rollback();
+    check(stockOf(station, "beef") == 9 && stockOf(station, "bun") == 10, "reserveIngredients(count): rollback returns all four");
+
+    check(station.canCompleteOrder(stew->getNameId()), "Stew: each listed amount of salt is in stock on its own");
+    KitchenStation::Reservation reservation;
+    check(station.reserveIngredients(stew->getNameId(), 3, reservation) == 0 && !reservation.isPending(), "Stew: six salt in total is too much");
+    check(!station.prepareDish(stew->getNameId()), "Stew: prepareDish fails too");
+    check(station.getIngredientsStock().size() == 4 && stockOf(station, "salt") == 5 && stockOf(station, "pepper") == 1,
+          "Stew: the salt taken before running short is put back");
+}
+
+// what is left after preparing from the queue
+struct PrepareResult {
+    int prepared;
+    std::vector<std::string> queue;
+    std::vector<std::string> stock; // "station ingredient quantity", station and stock order
+};
+
+// the grill and a smoker both make burgers, the oven makes pizza; the burgers run out of beef at the
+// grill and of buns at the smoker
+PrepareResult prepareFromQueue(bool batch, bool with_registry, int n) {
+    TestKitchen kitchen;
+    KitchenStation smoker("Smoker");
+    smoker.assignDishToStation(makeDish(kitchen.dishes, "Burger", kitchen.burger->getIngredients()));
+    kitchen.manager.addStation(&smoker);
+    kitchen.stock(kitchen.grill, "beef", 7);
+    kitchen.stock(kitchen.grill, "bun", 10);
+    kitchen.stock(smoker, "bun", 2);
+    kitchen.stock(smoker, "beef", 10);
+    kitchen.stock(kitchen.oven, "dough", 6);
+    kitchen.stock(kitchen.oven, "cheese", 6);
+    if (with_registry) {
+        kitchen.manager.enableStationRegistry();
+    }
+    Dish* b = kitchen.burger;
+    Dish* p = kitchen.pizza;
+    kitchen.manager.addDishesToQueue({b, b, b, b, p, p, p, b, b, b, p, b});
+
+    PrepareResult result;
+    if (batch) {
+        result.prepared = kitchen.manager.prepareDishes(n);
+    } else {
+        result.prepared = 0;
+        while (result.prepared < n && kitchen.manager.prepareNextDish()) {
+            result.prepared++;
+        }
+    }
+    for (Dish* dish : kitchen.queue()) {
+        result.queue.push_back(dish->getName());
+    }
+    for (KitchenStation* station : {&kitchen.grill, &kitchen.oven, &smoker}) {
+        for (const Ingredient& ingredient : station->getIngredientsStock()) {
+            result.stock.push_back(station->getName() + " " + ingredient.name + " " + std::to_string(ingredient.quantity));
+        }
+    }
+    return result;
+}
+
+// prepareDishes gives the same result as calling prepareNextDish until it fails or n dishes are done,
+// including runs that spill over to the next station and a run cut short by the stock
+void testPrepareDishesMatchesOneAtATime() {
+    for (bool with_registry : {false, true}) {
+        for (int n : {2, 6, 9, 100}) {
+            PrepareResult batch = prepareFromQueue(true, with_registry, n);
+            PrepareResult single = prepareFromQueue(false, with_registry, n);
+            std::string name = "prepareDishes(" + std::to_string(n) + ")" + (with_registry ? " with registry" : "");
+            check(batch.prepared == single.prepared, name + ": same number prepared");
+            check(batch.queue == single.queue, name + ": same queue left");
+            check(batch.stock == single.stock, name + ": same stock left");
+        }
+    }
+    check(prepareFromQueue(true, false, 100).prepared == 8, "prepareDishes: stops at the burger no station has beef and buns for");
+}
+
+std::vector<std::string> describe(const std::vector<Ingredient>& ingredients) {
+    std::vector<std::string> lines;
+    for (const Ingredient& ingredient : ingredients) {
+        lines.push_back(ingredient.name + " " + std::to_string(ingredient.quantity));
+    }
+    return lines;
+}
+
+// takeAll draws from every listed ingredient or from none, whichever shards they live in
+void testBackupTakeAll() {
+    BackupInventory backup;
+    std::vector<Ingredient> stock;
+    const char* names[] = {"flour", "sugar", "salt", "yeast", "butter", "milk", "eggs", "honey", "oil", "vinegar",
+                           "rice", "beans", "corn", "peas", "basil", "thyme", "sage", "mint", "dill", "cumin"};
+    for (const char* name : names) {
+        stock.push_back(Ingredient(name, 5, 0, 1.0));
+    }
+    stock.push_back(Ingredient("flour", 7, 0, 1.0)); // a second flour entry, drawn from once the first is used up
+    backup.assign(stock);
+    auto id = [](const std::string& name) { return SymbolTable::ingredients().lookup(name); };
+
+    std::vector<std::pair<int, int>> too_much;
+    for (const char* name : names) {
+        too_much.push_back({id(name), 1});
+    }
+    too_much.push_back({id("mint"), 5}); // 6 mint in total, one more than there is
+    std::vector<std::string> before = describe(backup.snapshot());
+    check(!backup.takeAll(too_much), "BackupInventory: takeAll fails if one ingredient is short");
+    check(describe(backup.snapshot()) == before, "BackupInventory: a failed takeAll changes nothing in any shard");
+    check(!backup.takeAll({{id("salt"), 1}, {SymbolTable::NO_ID, 1}}) && backup.available(id("salt")) == 5,
+          "BackupInventory: an unknown ingredient fails the whole takeAll");
+
+    check(backup.takeAll({{id("flour"), 2}, {id("flour"), 3}, {id("honey"), 4}, {id("cumin"), 1}}),
+          "BackupInventory: takeAll succeeds when everything is covered");
+    std::vector<std::string> after = describe(backup.snapshot());
+    check(after.size() == 20 && after[0] == "sugar 5" && after.back() == "flour 7",
+          "BackupInventory: the used-up first flour entry is removed and the second one is next");
+    check(backup.available(id("honey")) == 1 && backup.available(id("cumin")) == 4 && backup.available(id("flour")) == 7,
+          "BackupInventory: each amount is deducted once");
+}
+
+// threads drawing the same two ingredients in opposite orders: no deadlock, no lost or double draw
+void testBackupTakeAllConcurrent() {
+    BackupInventory backup;
+    backup.assign({Ingredient("lentils", 1000, 0, 1.0), Ingredient("onions", 500, 0, 1.0)});
+    int lentils = SymbolTable::ingredients().lookup("lentils");
+    int onions = SymbolTable::ingredients().lookup("onions");
+    std::atomic<int> successes(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&backup, &successes, lentils, onions, t]() {
+            std::vector<std::pair<int, int>> amounts = (t % 2 == 0)
+                ? std::vector<std::pair<int, int>>{{lentils, 2}, {onions, 1}}
+                : std::vector<std::pair<int, int>>{{onions, 1}, {lentils, 2}};
+            while (backup.takeAll(amounts)) {
+                successes++;
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    check(successes.load() == 500 && backup.size() == 0, "BackupInventory: concurrent takeAll draws exactly what was there");
+}
+
+// a station short of two ingredients is topped up with both from backup, or with neither
+void testReplenishDeficitsAllOrNothing() {
+    TestKitchen kitchen;
+    kitchen.stock(kitchen.oven, "dough", 1);
+    kitchen.stock(kitchen.oven, "cheese", 1);
+    kitchen.manager.addBackupIngredient(Ingredient("dough", 5, 0, 0.5));
+    kitchen.manager.addDishToQueue(kitchen.pizza);
+    kitchen.manager.processAllDishes();
+    check(kitchen.queue() == std::vector<Dish*>{kitchen.pizza}, "replenish: no backup cheese, so the pizza stays queued");
+    check(describe(kitchen.manager.getBackupIngredients()) == std::vector<std::string>{"dough 5"} &&
+          stockOf(kitchen.oven, "dough") == 1 && stockOf(kitchen.oven, "cheese") == 1,
+          "replenish: the dough deficit is not drawn on its own");
+
+    kitchen.manager.addBackupIngredient(Ingredient("cheese", 1, 0, 1.0));
+    kitchen.manager.processAllDishes();
+    check(kitchen.queue().empty(), "replenish: with backup cheese the pizza is prepared");
+    check(describe(kitchen.manager.getBackupIngredients()) == std::vector<std::string>{"dough 4"},
+          "replenish: exactly the two deficits are drawn");
+}
+
+bool sameEvent(const KitchenEventSink::Event& a, const KitchenEventSink::Event& b) {
+    return a.type == b.type && a.dish_id == b.dish_id && a.station_id == b.station_id;
+}
+
+// the ring keeps the newest events, reads them back oldest first and dumps them as raw records
+void testRingLogEventSink() {
+    using Type = KitchenEventSink::EventType;
+    RingLogEventSink ring(3);
+    for (int i = 0; i < 5; i++) {
+        ring.emit({Type::ATTEMPTING, i, 100 + i});
+    }
+    check(ring.size() == 3 && ring.emitted() == 5, "RingLogEventSink: keeps the capacity, counts every event");
+    check(sameEvent(ring.at(0), {Type::ATTEMPTING, 2, 102}) && sameEvent(ring.at(2), {Type::ATTEMPTING, 4, 104}),
+          "RingLogEventSink: the oldest events are overwritten");
+
+    std::ostringstream out;
+    ring.writeTo(out);
+    std::string bytes = out.str();
+    bool records_match = bytes.size() == 3 * sizeof(KitchenEventSink::Event);
+    for (size_t i = 0; records_match && i < 3; i++) {
+        KitchenEventSink::Event record;
+        bytes.copy(reinterpret_cast<char*>(&record), sizeof(record), i * sizeof(record));
+        records_match = sameEvent(record, ring.at(i));
+    }
+    check(records_match, "RingLogEventSink: writeTo dumps the kept records oldest first across the wrap");
+
+    ring.clear();
+    check(ring.size() == 0 && ring.emitted() == 0, "RingLogEventSink: clear drops every event");
+}
+
+// every step of processing reaches the sink, in order, and the deterministic parallel run reports
+// exactly the same events as processAllDishes
+void testEventsReachTheSink() {
+    using Type = KitchenEventSink::EventType;
+    std::vector<std::vector<KitchenEventSink::Event>> runs;
+    for (int mode = 0; mode < 2; mode++) {
+        TestKitchen kitchen;
+        RingLogEventSink ring(1024);
+        kitchen.manager.setEventSink(&ring);
+        runSmallShift(kitchen, mode);
+        std::vector<KitchenEventSink::Event> events;
+        for (size_t i = 0; i < ring.size(); i++) {
+            events.push_back(ring.at(i));
+        }
+        runs.push_back(events);
+    }
+
+    const std::vector<KitchenEventSink::Event>& events = runs[0];
+    int burger = SymbolTable::dishes().lookup("Burger");
+    int grill = SymbolTable::stations().lookup("Grill");
+    std::vector<KitchenEventSink::Event> first_dish = {
+        {Type::DISH_STARTED, burger, SymbolTable::NO_ID},
+        {Type::ATTEMPTING, burger, grill},
+        {Type::PREPARED, burger, grill},
+        {Type::DISH_PREPARED, burger, SymbolTable::NO_ID}};
+    bool starts_right = events.size() > first_dish.size();
+    for (size_t i = 0; starts_right && i < first_dish.size(); i++) {
+        starts_right = sameEvent(events[i], first_dish[i]);
+    }
+    check(starts_right, "events: the first burger is started, attempted and prepared at the grill");
+    int replenished = 0, not_prepared = 0;
+    for (const KitchenEventSink::Event& event : events) {
+        replenished += event.type == Type::REPLENISHED;
+        not_prepared += event.type == Type::DISH_NOT_PREPARED;
+    }
+    check(replenished == 1 && not_prepared == 1, "events: one replenishment from backup, one dish not prepared");
+    check(!events.empty() && events.back().type == Type::ALL_PROCESSED, "events: the run ends with ALL_PROCESSED");
+
+    bool same = runs[0].size() == runs[1].size();
+    for (size_t i = 0; same && i < runs[0].size(); i++) {
+        same = sameEvent(runs[0][i], runs[1][i]);
+    }
+    check(same, "events: processAllDishesParallel(deterministic) reports what processAllDishes does");
+}
+
+// the NullEventSink keeps the console quiet without changing the outcome; setEventSink(nullptr) brings
+// the usual lines back
+void testNullEventSinkAndConsoleDefault() {
+    std::ostringstream console;
+    std::streambuf* saved = std::cout.rdbuf(console.rdbuf());
+    TestKitchen quiet_kitchen; // reports to a NullEventSink
+    runSmallShift(quiet_kitchen, 0);
+    std::string quiet_output = console.str();
+
+    TestKitchen loud_kitchen;
+    loud_kitchen.manager.setEventSink(nullptr);
+    runSmallShift(loud_kitchen, 0);
+    std::string loud_output = console.str().substr(quiet_output.size());
+    std::cout.rdbuf(saved);
+
+    check(quiet_output.empty(), "NullEventSink: nothing is printed");
+    check(quiet_kitchen.queue() == std::vector<Dish*>{quiet_kitchen.calzone} && stockOf(quiet_kitchen.grill, "beef") == 4,
+          "NullEventSink: the dishes are processed all the same");
+    check(loud_output.compare(0, 22, "PREPARING DISH: Burger") == 0 &&
+          loud_output.find("All dishes have been processed.") != std::string::npos,
+          "setEventSink(nullptr): the usual lines go to std::cout");
+}
+
+// a list whose chain, tail pointer and count can be checked against each other
+class CheckedList : public LinkedList<int> {
+public:
+    using LinkedList<int>::removeAfter;
+    using LinkedList<int>::moveToFront;
+
+    // whether the list holds exactly `expected` in order, read through both the iterator and the chain,
+    // with tail_ptr_ on the last node and item_count_ matching
+    bool holds(const std::vector<int>& expected) const {
+        std::vector<int> iterated(begin(), end());
+        std::vector<int> chained;
+        Node<int>* last = nullptr;
+        for (Node<int>* node = head_ptr_; node != nullptr; node = node->getNext()) {
+            chained.push_back(node->getItem());
+            last = node;
+        }
+        return iterated == expected && chained == expected && tail_ptr_ == last &&
+               item_count_ == static_cast<int>(expected.size());
+    }
+
+    // the node at position, through the iterator
+    Node<int>* nodeAt(int position) const {
+        return std::next(begin(), position).getNode();
+    }
+
+    // appends at the back, the path that relies on tail_ptr_
+    bool append(int item) {
+        return insert(getLength(), item);
+    }
+};
+
+// the iterator reads the list front to back, and the tail pointer follows every insert and removal,
+// including removing the tail and emptying the list, so appending afterwards still goes to the back
+void testLinkedListTail() {
+    CheckedList list;
+    check(list.holds({}) && list.begin() == list.end(), "LinkedList: an empty list has begin() == end()");
+    for (int i = 1; i <= 5; i++) {
+        list.append(i);
+    }
+    list.insert(0, 0);
+    list.insert(3, 99);
+    check(list.holds({0, 1, 2, 99, 3, 4, 5}), "LinkedList: inserts at the front, middle and back");
+    CheckedList::Iterator second = ++list.begin();
+    check(*second == 1 && *second++ == 1 && *second == 2 && second.getNode() == list.nodeAt(2), "LinkedList: iterator increments");
+
+    check(list.remove(6) && list.holds({0, 1, 2, 99, 3, 4}) && list.append(6) && list.holds({0, 1, 2, 99, 3, 4, 6}),
+          "LinkedList: remove the tail, then append");
+    check(list.removeAfter(list.nodeAt(5)) && list.holds({0, 1, 2, 99, 3, 4}) && list.append(7) &&
+          list.holds({0, 1, 2, 99, 3, 4, 7}), "LinkedList: removeAfter the node before the tail, then append");
+    check(!list.removeAfter(list.nodeAt(6)) && list.holds({0, 1, 2, 99, 3, 4, 7}), "LinkedList: nothing after the tail to remove");
+    check(list.removeAfter(nullptr) && list.remove(2) && list.holds({1, 2, 3, 4, 7}), "LinkedList: remove the head and a middle node");
+
+    CheckedList copy(list);
+    check(copy.holds({1, 2, 3, 4, 7}) && copy.append(8) && copy.holds({1, 2, 3, 4, 7, 8}) && list.holds({1, 2, 3, 4, 7}),
+          "LinkedList: a copy has its own tail");
+
+    while (list.removeAfter(nullptr)) {
+    }
+    check(list.holds({}) && list.append(10) && list.append(11) && list.holds({10, 11}), "LinkedList: empty by removing the head, then append");
+    list.clear();
+    check(list.holds({}) && list.append(12) && list.holds({12}), "LinkedList: clear, then append");
+    check(!list.insert(3, 13) && !list.remove(1) && list.holds({12}), "LinkedList: positions out of range are refused");
+}
+
+// moveToFront relinks a node without allocating: moving the tail leaves the node before it as the tail,
+// and appending afterwards still goes to the back
+void testLinkedListMoveToFront() {
+    CheckedList list;
+    for (int i = 0; i < 5; i++) {
+        list.append(i);
+    }
+    Node<int>* tail = list.nodeAt(4);
+    list.moveToFront(list.nodeAt(3));
+    check(list.holds({4, 0, 1, 2, 3}) && list.getHeadNode() == tail, "LinkedList: moveToFront the tail relinks the same node");
+    check(list.append(5) && list.holds({4, 0, 1, 2, 3, 5}), "LinkedList: append after moving the tail");
+    list.moveToFront(list.nodeAt(2));
+    check(list.holds({2, 4, 0, 1, 3, 5}), "LinkedList: moveToFront a middle node");
+    list.moveToFront(nullptr);
+    list.moveToFront(list.nodeAt(5));
+    check(list.holds({2, 4, 0, 1, 3, 5}), "LinkedList: moveToFront the head or past the tail changes nothing");
+
+    CheckedList pair;
+    pair.append(1);
+    pair.append(2);
+    pair.moveToFront(pair.nodeAt(0));
+    check(pair.holds({2, 1}) && pair.removeAfter(pair.nodeAt(0)) && pair.holds({2}) && pair.append(3) && pair.holds({2, 3}),
+          "LinkedList: swap a two-node list, remove the new tail, append");
+}
+
+// a pool hands freed nodes back out, newest first, and only starts a slab when none are free; a list
+// emptied and refilled reuses the same nodes
+void testNodePoolReusesNodes() {
+    NodePool<int> pool;
+    std::vector<Node<int>*> nodes;
+    for (int i = 0; i < 200; i++) {
+        nodes.push_back(pool.allocate(1));
+    }
+    std::set<Node<int>*> first_round(nodes.begin(), nodes.end());
+    check(first_round.size() == 200, "NodePool: every node is distinct across slabs");
+
+    pool.deallocate(nodes[10], 1);
+    pool.deallocate(nodes[150], 1);
+    check(pool.allocate(1) == nodes[150] && pool.allocate(1) == nodes[10], "NodePool: freed nodes come back newest first");
+    for (Node<int>* node : nodes) {
+        pool.deallocate(node, 1);
+    }
+    std::set<Node<int>*> second_round;
+    for (int i = 0; i < 200; i++) {
+        second_round.insert(pool.allocate(1));
+    }
+    check(second_round == first_round, "NodePool: refilling reuses the freed nodes, no new slab");
+    for (Node<int>* node : second_round) {
+        pool.deallocate(node, 1);
+    }
+
+    Node<int>* block = pool.allocate(3);
+    check(first_round.count(block) == 0, "NodePool: a request for several nodes comes from the system");
+    pool.deallocate(block, 3);
+    NodePool<int> other;
+    check(pool == pool && pool != other, "NodePool: a pool only equals itself");
+
+    CheckedList list;
+    for (int i = 0; i < 100; i++) {
+        list.append(i);
+    }
+    std::set<Node<int>*> used;
+    for (auto it = list.begin(); it != list.end(); ++it) {
+        used.insert(it.getNode());
+    }
+    list.clear();
+    for (int i = 0; i < 100; i++) {
+        list.append(i);
+    }
+    std::set<Node<int>*> reused;
+    for (auto it = list.begin(); it != list.end(); ++it) {
+        reused.insert(it.getNode());
+    }
+    check(reused == used, "NodePool: a list cleared and refilled reuses its nodes");
+}
+
+// whether the manager lists exactly the stations named in `names`, in order, every one of them is found
+// by name, and none of the names in `gone` is
+bool listsStations(const StationManager& manager, const std::vector<std::string>& names, const std::vector<std::string>& gone) {
+    std::vector<std::string> listed;
+    for (KitchenStation* station : manager) {
+        listed.push_back(station->getName());
+    }
+    bool found = listed == names && manager.getLength() == static_cast<int>(names.size());
+    for (const std::string& name : names) {
+        KitchenStation* station = manager.findStation(name);
+        found = found && station != nullptr && station->getName() == name;
+    }
+    for (const std::string& name : gone) {
+        found = found && manager.findStation(name) == nullptr;
+    }
+    return found;
+}
+
+// the index maps each name to the node before its station, so every removal, move and merge has to fix
+// up the entry of the station after it; every name is looked up again after each one
+void testStationIndexAfterReordering() {
+    std::deque<KitchenStation> stations;
+    StationManager manager;
+    for (const char* name : {"A", "B", "C", "D", "E", "F", "G", "H"}) {
+        stations.emplace_back(name);
+        manager.addStation(&stations.back());
+    }
+    check(listsStations(manager, {"A", "B", "C", "D", "E", "F", "G", "H"}, {}), "station index: after adding");
+    check(!manager.addStation(&stations[1]), "station index: a second station with the same name is refused");
+
+    check(manager.removeStation("A") && listsStations(manager, {"B", "C", "D", "E", "F", "G", "H"}, {"A"}), "station index: remove the first station");
+    check(manager.removeStation("D") && listsStations(manager, {"B", "C", "E", "F", "G", "H"}, {"A", "D"}), "station index: remove a middle station");
+    check(manager.removeStation("H") && listsStations(manager, {"B", "C", "E", "F", "G"}, {"A", "D", "H"}), "station index: remove the last station");
+    check(!manager.removeStation("H") && !manager.moveStationToFront("D"), "station index: a removed station can't be removed or moved");
+    check(manager.addStation(&stations[7]) && listsStations(manager, {"B", "C", "E", "F", "G", "H"}, {"A", "D"}),
+          "station index: add after removing the last station");
+
+    check(manager.moveStationToFront("H") && listsStations(manager, {"H", "B", "C", "E", "F", "G"}, {"A", "D"}), "station index: move the last station to the front");
+    check(manager.moveStationToFront("E") && listsStations(manager, {"E", "H", "B", "C", "F", "G"}, {"A", "D"}), "station index: move a middle station to the front");
+    check(manager.moveStationToFront("E") && listsStations(manager, {"E", "H", "B", "C", "F", "G"}, {"A", "D"}), "station index: move the first station to the front");
+    check(manager.addStation(&stations[0]) && listsStations(manager, {"E", "H", "B", "C", "F", "G", "A"}, {"D"}),
+          "station index: add after moving the last station");
+
+    check(manager.mergeStations("B", "E") && listsStations(manager, {"H", "B", "C", "F", "G", "A"}, {"D", "E"}), "station index: merge away the first station");
+    check(manager.mergeStations("H", "C") && listsStations(manager, {"H", "B", "F", "G", "A"}, {"C", "D", "E"}), "station index: merge away a middle station");
+    check(manager.mergeStations("F", "A") && listsStations(manager, {"H", "B", "F", "G"}, {"A", "C", "D", "E"}), "station index: merge away the last station");
+    check(!manager.mergeStations("F", "F") && !manager.mergeStations("F", "A"), "station index: merging a station with itself or a removed one fails");
+}
+
+// the names of a station's stock entries, in order
+std::vector<std::string> stockNames(const KitchenStation& station) {
+    std::vector<std::string> names;
+    for (const Ingredient& ingredient : station.getIngredientsStock()) {
+        names.push_back(ingredient.name);
+    }
+    return names;
+}
+
+// entries used up by a reservation go back where they were when it is rolled back, whether the rollback
+// is explicit, on destruction, or inside a reserve that runs short
+void testRollbackKeepsStockOrder() {
+    DishArena dishes;
+    KitchenStation station("Line");
+    // uses up salt (the first entry), pepper (a middle one) and oil (the last), and takes some of the rice
+    Dish* stir_fry = makeDish(dishes, "Stir Fry", {Ingredient("pepper", 0, 2, 1.0), Ingredient("oil", 0, 1, 1.0),
+                                                   Ingredient("salt", 0, 1, 1.0), Ingredient("rice", 0, 1, 1.0)});
+    // salt is listed twice: both pass the per-ingredient check, but the second runs short after the first
+    Dish* salty = makeDish(dishes, "Salty", {Ingredient("salt", 0, 1, 1.0), Ingredient("pepper", 0, 2, 1.0),
+                                             Ingredient("salt", 0, 1, 1.0)});
+    station.assignDishToStation(stir_fry);
+    station.assignDishToStation(salty);
+    for (const char* name : {"salt", "rice", "pepper", "garlic", "oil"}) {
+        station.replenishStationIngredients(Ingredient(name, std::string(name) == "pepper" ? 2 : 1, 0, 1.0));
+    }
+    const std::vector<std::string> order = {"salt", "rice", "pepper", "garlic", "oil"};
+    {
+        KitchenStation::Reservation reservation;
+        station.reserveIngredients(stir_fry->getNameId(), reservation);
+        check(stockNames(station) == std::vector<std::string>{"garlic"}, "rollback order: the used-up entries are removed while pending");
+        reservation.rollback();
+        check(stockNames(station) == order && stockOf(station, "pepper") == 2, "rollback order: rollback puts entries back where they were");
+    }
+    {
+        KitchenStation::Reservation reservation;
+        check(station.reserveIngredients(stir_fry->getNameId(), 3, reservation) == 1, "rollback order: one stir fry fits");
+    }
+    check(stockNames(station) == order, "rollback order: a reservation rolled back on destruction keeps the order");
+    {
+        KitchenStation::Reservation reservation;
+        check(!station.reserveIngredients(salty->getNameId(), reservation), "rollback order: the salty recipe runs short");
+    }
+    check(stockNames(station) == order && stockOf(station, "salt") == 1, "rollback order: a reserve that runs short keeps the order");
+    check(!station.prepareDish("Salty") && stockNames(station) == order, "rollback order: a failed prepareDish keeps the order");
+}
+
+// A dish that can't be made is parked on the ingredients it was short of, and its failure is replayed
+// for later dishes of the same name until one of those ingredients goes up. "Grate" gives the oven a
+// cheese back (a negative requirement), which is the one way stock rises while the queue drains without
+// a backup. The burger can't be made at all, so it is the first unprepared dish and the pass runs on
+// past the parked dishes.
+void testParkedDishWakesOnRestock() {
+    TestKitchen kitchen;
+    Dish* grate = makeDish(kitchen.dishes, "Grate", {Ingredient("cheese", 0, -1, 1.0)});
+    kitchen.oven.assignDishToStation(grate);
+    kitchen.stock(kitchen.oven, "dough", 10);
+    kitchen.stock(kitchen.oven, "cheese", 1);
+
+    // the first pizza parks on the missing cheese, the grated cheese wakes it, and the second pizza is made
+    Dish* pizza1 = makeDish(kitchen.dishes, "Pizza", kitchen.pizza->getIngredients());
+    Dish* pizza2 = makeDish(kitchen.dishes, "Pizza", kitchen.pizza->getIngredients());
+    kitchen.manager.addDishesToQueue({kitchen.burger, pizza1, grate, pizza2});
+    kitchen.manager.processAllDishes();
+    check(kitchen.queue() == std::vector<Dish*>{kitchen.burger, pizza1}, "parked dish: prepared once its ingredient is restocked");
+    check(stockOf(kitchen.oven, "dough") == 8 && !kitchen.oven.isStocked(SymbolTable::ingredients().lookup("cheese")),
+          "parked dish: the woken dish takes its ingredients");
+}
+
+// as above, but the first restock covers only part of what the parked dish needs
+void testParkedDishStaysParkedOnPartialRestock() {
+    TestKitchen kitchen;
+    Dish* grate = makeDish(kitchen.dishes, "Grate", {Ingredient("cheese", 0, -1, 1.0)});
+    kitchen.oven.assignDishToStation(grate);
+    kitchen.stock(kitchen.oven, "dough", 10);
+    kitchen.stock(kitchen.oven, "cheese", 1);
+
+    // a calzone needs 3 cheese: one grated cheese wakes the parked calzone but is not enough, so it parks
+    // again and the next calzone replays the failure; the second grated cheese is enough
+    std::vector<Dish*> calzones;
+    for (int i = 0; i < 4; i++) {
+        calzones.push_back(makeDish(kitchen.dishes, "Calzone", kitchen.calzone->getIngredients()));
+    }
+    Dish* grate2 = makeDish(kitchen.dishes, "Grate", grate->getIngredients());
+    RingLogEventSink log(256);
+    kitchen.manager.setEventSink(&log);
+    kitchen.manager.addDishesToQueue({kitchen.burger, calzones[0], grate, calzones[1], calzones[2], grate2, calzones[3]});
+    kitchen.manager.processAllDishes();
+    check(kitchen.queue() == std::vector<Dish*>{kitchen.burger, calzones[0], calzones[1], calzones[2]},
+          "parked dish: stays unprepared while only part of what it needs has arrived");
+    check(stockOf(kitchen.oven, "dough") == 7 && !kitchen.oven.isStocked(SymbolTable::ingredients().lookup("cheese")),
+          "parked dish: only the last calzone takes stock");
+
+    int calzone_id = calzones[0]->getNameId();
+    int prepared = 0, not_prepared = 0;
+    check(log.emitted() == log.size(), "parked dish: the log holds every event");
+    for (size_t i = 0; i < log.size(); i++) {
+        const KitchenEventSink::Event& event = log.at(i);
+        if (event.dish_id == calzone_id && event.type == KitchenEventSink::EventType::DISH_PREPARED) {
+            prepared++;
+        } else if (event.dish_id == calzone_id && event.type == KitchenEventSink::EventType::DISH_NOT_PREPARED) {
+            not_prepared++;
+        }
+    }
+    check(prepared == 1 && not_prepared == 3, "parked dish: every calzone is still reported");
+}
+
+// a dish that records its destruction, with PADDING bytes of payload (more than BLOCK_SIZE for a big dish)
+template<size_t PADDING>
+class TracedDish : public Appetizer {
+public:
+    TracedDish(int id, std::vector<int>& destroyed) : Appetizer(), id_(id), destroyed_(destroyed) {
+        padding_[0] = padding_[PADDING - 1] = static_cast<unsigned char>(id);
+    }
+    ~TracedDish() override {
+        destroyed_.push_back(id_);
+    }
+    bool intact() const {
+        return padding_[0] == static_cast<unsigned char>(id_) && padding_[PADDING - 1] == static_cast<unsigned char>(id_);
+    }
+
+private:
+    int id_;
+    std::vector<int>& destroyed_;
+    unsigned char padding_[PADDING];
+};
+
+// release() runs each derived destructor once, newest first, keeps the first block for the next shift,
+// and dishes bigger than a block get blocks of their own
+void testDishArenaRelease() {
+    using SmallDish = TracedDish<16>;
+    using BigDish = TracedDish<DishArena::BLOCK_SIZE * 2>;
+    std::vector<int> destroyed;
+    DishArena arena;
+
+    SmallDish* first = arena.make<SmallDish>(1, destroyed);
+    std::vector<SmallDish*> small = {first};
+    BigDish* big = arena.make<BigDish>(2, destroyed);
+    for (int id = 3; id < 200; id++) { // enough to fill several blocks
+        small.push_back(arena.make<SmallDish>(id, destroyed));
+    }
+    BigDish* big2 = arena.make<BigDish>(200, destroyed);
+    check(arena.size() == 200 && destroyed.empty(), "DishArena: make constructs without destroying");
+    bool intact = big->intact() && big2->intact();
+    for (SmallDish* dish : small) {
+        intact = intact && dish->intact() && reinterpret_cast<uintptr_t>(dish) % alignof(SmallDish) == 0;
+    }
+    check(intact, "DishArena: dishes, big ones included, don't overlap and are aligned");
+
+    arena.release();
+    std::vector<int> newest_first;
+    for (int id = 200; id >= 1; id--) {
+        newest_first.push_back(id);
+    }
+    check(destroyed == newest_first && arena.size() == 0, "DishArena: release destroys every dish once, newest first");
+
+    destroyed.clear();
+    SmallDish* next_shift = arena.make<SmallDish>(7, destroyed);
+    check(static_cast<void*>(next_shift) == static_cast<void*>(first), "DishArena: the next shift starts in the kept first block");
+    Dish* as_dish = arena.make<BigDish>(8, destroyed);
+    check(as_dish->getName() == "UNKNOWN" && arena.size() == 2, "DishArena: a big dish after release");
+}
+
+} // namespace
+
+int main() {
+    testLinkedListTail();
+    testLinkedListMoveToFront();
+    testNodePoolReusesNodes();
+    testStationIndexAfterReordering();
+    testStationWorkerRunsTasksInOrder();
+    testDishArenaRelease();
+    testParallelMatchesSerial();
+    testParallelKeepsUnpreparedInOrder();
+    testMpmcQueueBatches();
+    testMpmcQueueConcurrent();
+    testIntakeOverflowKeepsOrder();
+    testIntakeConcurrentProducers();
+    testRegistrySeesRecipeChanges();
+    testRegistryRecipeNeedsUnstockedIngredient();
+    testReservationCommitAndRollback();
+    testRollbackKeepsStockOrder();
+    testReserveSeveralAndShortRecipe();
+    testPrepareDishesMatchesOneAtATime();
+    testParkedDishWakesOnRestock();
+    testParkedDishStaysParkedOnPartialRestock();
+    testBackupTakeAll();
+    testBackupTakeAllConcurrent();
+    testReplenishDeficitsAllOrNothing();
+    testRingLogEventSink();
+    testEventsReachTheSink();
+    testNullEventSinkAndConsoleDefault();
+
+    if (failures > 0) {
+        std::cout << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All tests passed" << std::endl;
+    return 0;
+}
@@ -10,7 +10,8 @@
  */
 
 #include "Appetizer.hpp"
-#include <set>
+#include "DietaryRules.hpp"
+#include <algorithm>
 /**
  * Default constructor.
  * Initializes all private members with default values.
@@ -161,47 +162,14 @@ without substitution.
 */
 
 void Appetizer::dietaryAccommodations(Dish::DietaryRequest request) {
-    std::set<std::string> meats = {"Meat", "Chicken", "Fish", "Beef", "Pork", "Lamb", "Shrimp", "Bacon"};
-    std::set<std::string> gluten = {"Wheat", "Flour", "Bread", "Pasta", "Barley", "Rye", "Oats", "Crust"};
-    std::vector<std::string> meat_sub = {"Beans", "Mushrooms"};
-
-    std::vector<std::string> ingredients = getIngredients();
-
-    size_t meat_counter = 0;
-
     if (request.vegetarian) {
         vegetarian_ = true;
     }
 
-    size_t i = 0;
-    if (request.vegetarian || request.gluten_free) {
-        while (i < ingredients.size()) {
-            bool removed = false;
-
-            // Handle vegetarian replacements and removal
-            if (request.vegetarian && meats.find(ingredients[i]) != meats.end()) {
-                if (meat_counter < 2) {
-                    ingredients[i] = meat_sub[meat_counter];
-                    meat_counter++;
-                } else {
-                    ingredients.erase(ingredients.begin() + i); //remove ingredient and shift others down (keeps order intact since only first and second instances of meat should be changed to Beans and Mushrooms)                 
-                    removed = true;
-                }
-            }
-
-            // Handle gluten-free removal, only if not already removed
-            if (!removed && request.gluten_free && gluten.find(ingredients[i]) != gluten.end()) {
-                ingredients.erase(ingredients.begin() + i);//remove ingredient and shift others down (keeps order intact since only first and second instances of meat should be changed to Beans and Mushrooms)
-                removed = true;
-            }
-
-            if (!removed) {
-                i++;
-            }
-        }
-    }
-
-    setIngredients(ingredients);//set ingredients back to the new vector
+    //one pass over the ingredients: the first two meats become Beans and Mushrooms and the rest are removed,
+    //and gluten is removed
+    applyIngredientRules(request.vegetarian ? DietaryRules::MEAT : 0,
+                         request.gluten_free ? DietaryRules::GLUTEN : 0);
 
     if (request.low_sodium) {
         spiciness_level_ = std::max(0, spiciness_level_ - 2);
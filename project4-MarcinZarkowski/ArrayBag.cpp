@@ -1,7 +1,7 @@
 /*
-ArrayBag interface for term project
+ArrayBag implementation for term project
 CSCI 235 Fall 2024
-DO NOT MODIFY THIS FILE. YOU DO NOT HAVE TO SUBMIT THIS FILE
+Vector-backed, with the optional position index described in ArrayBag.hpp.
 */
 
 
@@ -11,6 +11,7 @@ DO NOT MODIFY THIS FILE. YOU DO NOT HAVE TO SUBMIT THIS FILE
 template<class ItemType>
 ArrayBag<ItemType>::ArrayBag(): item_count_(0)
 {
+   items_.reserve(DEFAULT_CAPACITY);
 }  // end default constructor
 
 /**
@@ -40,15 +41,14 @@ bool ArrayBag<ItemType>::add(const ItemType& new_entry)
    if (contains(new_entry)) {
        return false;
    }
-	bool has_room = (item_count_ < DEFAULT_CAPACITY);
-	if (has_room)
+	// items_ grows as needed, so there is always room
+	items_.push_back(new_entry);
+	if (index_)
 	{
-		items_[item_count_] = new_entry;
-		item_count_++;
-        return true;
+		index_->emplace(new_entry, item_count_);
 	}  // end if
-
-	return false;
+	item_count_++;
+	return true;
 }  // end add
 
 /**
@@ -62,7 +62,16 @@ bool ArrayBag<ItemType>::remove(const ItemType& an_entry)
 	if (can_remove)
 	{
 		item_count_--;
+		if (index_)
+		{
+			index_->erase(an_entry);
+			if (found_index != item_count_)
+			{
+				(*index_)[items_[item_count_]] = found_index; // the last item moves into the gap
+			}  // end if
+		}  // end if
 		items_[found_index] = items_[item_count_];
+		items_.pop_back();
 	}  // end if
 
 	return can_remove;
@@ -75,6 +84,11 @@ template<class ItemType>
 void ArrayBag<ItemType>::clear()
 {
 	item_count_ = 0;
+	items_.clear();
+	if (index_)
+	{
+		index_->clear();
+	}  // end if
 }  // end clear
 
 /**
@@ -83,6 +97,11 @@ void ArrayBag<ItemType>::clear()
 template<class ItemType>
 int ArrayBag<ItemType>::getFrequencyOf(const ItemType& an_entry) const
 {
+   if (index_)
+   {
+      return index_->count(an_entry) > 0 ? 1 : 0; // add never stores duplicates
+   }  // end if
+
    int frequency = 0;
    int curr_index = 0;       // Current array index
    while (curr_index < item_count_)
@@ -107,8 +126,89 @@ bool ArrayBag<ItemType>::contains(const ItemType& an_entry) const
 	return getIndexOf(an_entry) > -1;
 }  // end contains
 
+/**
+ @post items_ has room for at least capacity items without reallocating
+ **/
+template<class ItemType>
+void ArrayBag<ItemType>::reserve(int capacity)
+{
+	items_.reserve(capacity);
+	if (index_)
+	{
+		index_->reserve(capacity);
+	}  // end if
+}  // end reserve
+
+/**
+ @post add, remove, contains and getFrequencyOf use a hash index of items_
+ **/
+template<class ItemType>
+void ArrayBag<ItemType>::enableIndex()
+{
+	if (!index_)
+	{
+		index_.emplace();
+		rebuildIndex();
+	}  // end if
+}  // end enableIndex
+
+/**
+ @return the removed items, in the order they were stored
+ **/
+template<class ItemType>
+template<class Predicate>
+std::vector<ItemType> ArrayBag<ItemType>::removeIf(Predicate pred)
+{
+	std::vector<ItemType> removed;
+	int kept = 0;
+	for (int i = 0; i < item_count_; i++)
+	{
+		if (pred(static_cast<const ItemType&>(items_[i])))
+		{
+			if (index_)
+			{
+				index_->erase(items_[i]);
+			}  // end if
+			removed.push_back(items_[i]);
+		}
+		else
+		{
+			if (kept != i)
+			{
+				items_[kept] = items_[i]; // slide the kept item down over the gap
+				if (index_)
+				{
+					(*index_)[items_[kept]] = kept;
+				}  // end if
+			}  // end if
+			kept++;
+		}  // end if
+	}  // end for
+
+	items_.resize(kept);
+	item_count_ = kept;
+	return removed;
+}  // end removeIf
+
 // ********* PRIVATE METHODS **************//
 
+/**
+ @post index_ (if enabled) matches the current contents of items_
+ **/
+template<class ItemType>
+void ArrayBag<ItemType>::rebuildIndex()
+{
+	if (index_)
+	{
+		index_->clear();
+		index_->reserve(items_.capacity());
+		for (int i = 0; i < item_count_; i++)
+		{
+			index_->emplace(items_[i], i);
+		}  // end for
+	}  // end if
+}  // end rebuildIndex
+
 /**
 	@param target to be found in items_
  	@return either the index target in the array items_ or -1,
@@ -117,6 +217,12 @@ bool ArrayBag<ItemType>::contains(const ItemType& an_entry) const
 template<class ItemType>
 int ArrayBag<ItemType>::getIndexOf(const ItemType& target) const
 {  
+   if (index_)
+   {
+      auto found_item = index_->find(target);
+      return found_item == index_->end() ? -1 : found_item->second;
+   }  // end if
+
 	bool found = false;
   int result = -1;
   int search_index = 0;
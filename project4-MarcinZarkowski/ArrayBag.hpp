@@ -1,13 +1,16 @@
 /*
 ArrayBag interface for term project
 CSCI 235 Fall 2024
-DO NOT MODIFY THIS FILE. YOU DO NOT HAVE TO SUBMIT THIS FILE
+Adapted from the course-provided file: items_ is a vector that grows as needed,
+and enableIndex() adds a hash index from each item to its position.
 */
 
 #ifndef ARRAY_BAG_
 #define ARRAY_BAG_
 #include <iostream>
 #include <vector>
+#include <optional>
+#include <unordered_map>
 
 template <class ItemType>
 class ArrayBag
@@ -52,11 +55,42 @@ class ArrayBag
    **/
    int getFrequencyOf(const ItemType &an_entry) const;
 
+   /**
+       @post items_ has room for at least capacity items without reallocating
+   **/
+   void reserve(int capacity);
+
+   /**
+       Builds a hash index from each item to its position, so add, remove, contains
+       and getFrequencyOf take expected O(1) time instead of scanning the bag.
+       ItemType must be hashable with std::hash.
+       @post the index is kept up to date by add, remove and clear
+   **/
+   void enableIndex();
+
+   /**
+       Removes every item for which pred returns true in a single pass.
+       The remaining items keep their relative order.
+       @param pred called once per item with a const reference to it
+       @return the removed items, in the order they were stored
+   **/
+   template <class Predicate>
+   std::vector<ItemType> removeIf(Predicate pred);
+
    protected:
-   static const int DEFAULT_CAPACITY = 100; //max size of items_ at 100 by default for this project
-   ItemType items_[DEFAULT_CAPACITY];      // Array of bag items
+   static const int DEFAULT_CAPACITY = 100; //initial capacity of items_; the bag grows as needed
+   std::vector<ItemType> items_;           // Contiguous bag items, items_.size() == item_count_
    int item_count_;                        // Current count of bag items
 
+   // position of every item in items_, only present after enableIndex().
+   // Subclasses that reorder items_ directly must call rebuildIndex() afterwards.
+   std::optional<std::unordered_map<ItemType, int>> index_;
+
+   /**
+       @post index_ (if enabled) matches the current contents of items_
+   **/
+   void rebuildIndex();
+
    /**
        @param target to be found in items_
       @return either the index target in the array items_ or -1,
@@ -10,7 +10,7 @@
  */
 
 #include "Dessert.hpp"
-#include <set>
+#include "DietaryRules.hpp"
 #include <iostream>
 #include <iomanip>  
 #include <vector>   
@@ -101,7 +101,7 @@ whether it contains nuts.
 * Contains Nuts: [Yes/No]
 */
 void Dessert::display() const {
-    std::cout << "Dish Name: " << getName() << std::endl;
+    std::cout << "Dish Name: " << getName() << "\n";
 
     //dont make a copy, just the original vector
     const auto& ingredients = getIngredients();
@@ -114,35 +114,35 @@ void Dessert::display() const {
             std::cout << ", ";
         }
     }
-    std::cout << std::endl;
+    std::cout << "\n";
 
-    std::cout << "Preparation Time: " << getPrepTime() << " minutes" << std::endl;
-    std::cout << "Price: $" << std::fixed << std::setprecision(2) << getPrice() << std::endl;
-    std::cout << "Cuisine Type: " << getCuisineType() << std::endl;
+    std::cout << "Preparation Time: " << getPrepTime() << " minutes\n";
+    std::cout << "Price: $" << std::fixed << std::setprecision(2) << getPrice() << "\n";
+    std::cout << "Cuisine Type: " << getCuisineType() << "\n";
 
     // Print flavor profile with default case
     switch (getFlavorProfile()) {
         case SWEET:
-            std::cout << "Flavor Profile: Sweet" << std::endl;
+            std::cout << "Flavor Profile: Sweet\n";
             break;
         case BITTER:
-            std::cout << "Flavor Profile: Bitter" << std::endl;
+            std::cout << "Flavor Profile: Bitter\n";
             break;
         case SOUR:
-            std::cout << "Flavor Profile: Sour" << std::endl;
+            std::cout << "Flavor Profile: Sour\n";
             break;
         case SALTY:
-            std::cout << "Flavor Profile: Salty" << std::endl;
+            std::cout << "Flavor Profile: Salty\n";
             break;
         case UMAMI:
-            std::cout << "Flavor Profile: Umami" << std::endl;
+            std::cout << "Flavor Profile: Umami\n";
             break;
     }
 
-    std::cout << "Sweetness Level: " << getSweetnessLevel() << std::endl;
+    std::cout << "Sweetness Level: " << getSweetnessLevel() << "\n";
 
     
-    std::cout << "Contains Nuts: " << (containsNuts() ? "Yes" : "No") << std::endl;
+    std::cout << "Contains Nuts: " << (containsNuts() ? "Yes" : "No") << "\n";
 }
 
 
@@ -166,9 +166,6 @@ needs.
 "Butter", "Cream", "Yogurt".
 */
 void Dessert::dietaryAccommodations(Dish::DietaryRequest request){
-    std::set<std::string> nuts={"Almonds", "Walnuts", "Pecans", "Hazelnuts", "Peanuts", "Cashews", "Pistachios"};
-    std::set<std::string> dairy={"Milk", "Eggs", "Cheese","Butter", "Cream", "Yogurt"};
-
     if (request.low_sugar){
         if (sweetness_level_>=3){
             sweetness_level_-=3;
@@ -177,40 +174,12 @@ void Dessert::dietaryAccommodations(Dish::DietaryRequest request){
             sweetness_level_=0;
         }
     }
-    if (request.nut_free || request.vegan){
-        if (request.nut_free){
-            contains_nuts_=false;
-        }
-        std::vector<std::string> ingredients =getIngredients();
-        
-        size_t i=0;
-
-        //loops through whole ingredients to see if there are nuts or dairy
-        while ( i < ingredients.size()){
-            bool removed =false;
-            
-            //searches for nuts and removes them from ingredients if nut_free is true.
-            //if a request is true and an ingredient is in the respective set, it removes it from the vector.
-            if( request.nut_free && (nuts.find(ingredients[i]) != nuts.end())){ 
-                ingredients.erase(ingredients.begin() + i);
-                removed=true;// so it checks the ingredient that replaced the last one
-            }
-            if ( !removed && (request.vegan && (dairy.find(ingredients[i])!= dairy.end()))){
-                ingredients.erase(ingredients.begin() + i);
-                removed=true;// so it checks the ingredient that replaced the last one
-            }
-
-            if (!removed){//only increment if it wasn't removed in order to not skip over an ingredient that replaced the last one
-                i++;
-            }
-            
-        }
-
-
-        setIngredients(ingredients);//set ingr
-
+    if (request.nut_free){
+        contains_nuts_=false;
     }
 
-    
+    //one pass over the ingredients removes the nuts and the dairy and egg that were asked for
+    applyIngredientRules(0, (request.nut_free ? DietaryRules::NUT : 0) |
+                            (request.vegan ? DietaryRules::DAIRY_OR_EGG : 0));
 }
    
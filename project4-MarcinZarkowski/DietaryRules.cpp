@@ -0,0 +1,57 @@
+/**
+ * @file DietaryRules.cpp
+ * @brief This file contains the implementation of the DietaryRules class.
+ */
+
+#include "DietaryRules.hpp"
+#include <initializer_list>
+#include <utility>
+
+DietaryRules::DietaryRules() {
+    auto mark = [this](uint8_t bit, std::initializer_list<const char*> names) {
+        for (const char* name : names) {
+            classes_[name] |= bit;
+        }
+    };
+    mark(MEAT, {"Meat", "Chicken", "Fish", "Beef", "Pork", "Lamb", "Shrimp", "Bacon"});
+    mark(DAIRY_OR_EGG, {"Milk", "Eggs", "Cheese", "Butter", "Cream", "Yogurt"});
+    mark(GLUTEN, {"Wheat", "Flour", "Bread", "Pasta", "Barley", "Rye", "Oats", "Crust"});
+    mark(NUT, {"Almonds", "Walnuts", "Pecans", "Hazelnuts", "Peanuts", "Cashews", "Pistachios"});
+}
+
+const DietaryRules& DietaryRules::instance() {
+    static const DietaryRules rules;
+    return rules;
+}
+
+uint8_t DietaryRules::classesOf(const std::string& ingredient) const {
+    auto it = classes_.find(ingredient);
+    return (it == classes_.end()) ? 0 : it->second;
+}
+
+bool DietaryRules::rewrite(std::vector<std::string>& ingredients, uint8_t replace, uint8_t drop) const {
+    static const char* const replacements[] = {"Beans", "Mushrooms"};
+    const std::size_t replacement_count = sizeof(replacements) / sizeof(replacements[0]);
+
+    std::size_t replaced = 0;
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < ingredients.size(); i++) {
+        uint8_t classes = classesOf(ingredients[i]);
+        if (classes & replace) {
+            if (replaced == replacement_count) {
+                continue; //past the replacements, drop it
+            }
+            ingredients[i] = replacements[replaced++];
+        } else if (classes & drop) {
+            continue;
+        }
+        if (kept != i) {
+            ingredients[kept] = std::move(ingredients[i]);
+        }
+        kept++;
+    }
+
+    bool changed = replaced > 0 || kept < ingredients.size();
+    ingredients.erase(ingredients.begin() + kept, ingredients.end());
+    return changed;
+}
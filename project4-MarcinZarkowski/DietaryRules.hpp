@@ -0,0 +1,56 @@
+/**
+ * @file DietaryRules.hpp
+ * @brief This file contains the definition of the DietaryRules class.
+ *
+ *DietaryRules is the table behind the dishes' dietaryAccommodations. Every ingredient class a DietaryRequest
+ *acts on (meat, dairy and egg, gluten, nuts) is one bit, and one table built on first use maps each listed
+ *ingredient name to its class bits, so an ingredient is classified with a single lookup instead of building
+ *and searching a std::set per class on every call. A dish's ingredients are then rewritten in a single
+ *stable pass that replaces and drops in place.
+ */
+
+#ifndef DIETARY_RULES_HPP
+#define DIETARY_RULES_HPP
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class DietaryRules {
+    public:
+        //ingredient classes
+        static constexpr uint8_t MEAT = 1 << 0;         // Meat, Chicken, Fish, Beef, Pork, Lamb, Shrimp, Bacon
+        static constexpr uint8_t DAIRY_OR_EGG = 1 << 1; // Milk, Eggs, Cheese, Butter, Cream, Yogurt
+        static constexpr uint8_t GLUTEN = 1 << 2;       // Wheat, Flour, Bread, Pasta, Barley, Rye, Oats, Crust
+        static constexpr uint8_t NUT = 1 << 3;          // Almonds, Walnuts, Pecans, Hazelnuts, Peanuts, Cashews, Pistachios
+
+        /**
+        * @return The rules, built on first use.
+        */
+        static const DietaryRules& instance();
+
+        /**
+        * @param ingredient The name of an ingredient.
+        * @return The classes the ingredient belongs to, or 0 for none.
+        */
+        uint8_t classesOf(const std::string& ingredient) const;
+
+        /**
+        * Rewrites a list of ingredients in one stable pass.
+        * @param ingredients The ingredient names.
+        * @param replace Classes whose first two ingredients become "Beans" and "Mushrooms" and whose later
+        ones are dropped.
+        * @param drop Classes whose ingredients are dropped.
+        * @post The other ingredients keep their order.
+        * @return True if any ingredient was replaced or dropped.
+        */
+        bool rewrite(std::vector<std::string>& ingredients, uint8_t replace, uint8_t drop) const;
+
+    private:
+        DietaryRules();
+
+        std::unordered_map<std::string, uint8_t> classes_;
+};
+
+#endif // DIETARY_RULES_HPP
@@ -10,6 +10,7 @@
  */
 
 #include "Dish.hpp"
+#include "DietaryRules.hpp"
 
 // Default Constructor
 Dish::Dish() 
@@ -27,7 +28,7 @@ std::string Dish::getName() const {
     return name_;
 }
 
-std::vector<std::string> Dish::getIngredients() const {
+const std::vector<std::string>& Dish::getIngredients() const {
     return ingredients_;
 }
 
@@ -51,6 +52,10 @@ std::string Dish::getCuisineType() const {
     }
 }
 
+Dish::CuisineType Dish::getCuisineTypeEnum() const {
+    return cuisine_type_;
+}
+
 // Mutator Functions
 void Dish::setName(const std::string& name) {
     if (isValidName(name)) {
@@ -63,6 +68,12 @@ void Dish::setName(const std::string& name) {
 void Dish::setIngredients(const std::vector<std::string>& ingredients) {
     ingredients_ = ingredients;
 }
+void Dish::applyIngredientRules(uint8_t replace, uint8_t drop) {
+    if (replace | drop) {
+        DietaryRules::instance().rewrite(ingredients_, replace, drop);
+    }
+}
+
 
 void Dish::setPrepTime(const int& prep_time) {
     prep_time_ = prep_time;
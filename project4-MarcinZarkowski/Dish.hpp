@@ -17,6 +17,7 @@
 #include <iostream>
 #include <iomanip> // For std::fixed and std::setprecision
 #include <cctype>  // For std::isalpha, std::isspace
+#include <cstdint>
 
 class Dish {
 public:
@@ -57,6 +58,18 @@ public:
      */
     Dish(const std::string& name, const std::vector<std::string>& ingredients = {}, int prep_time = 0, double price = 0.0, CuisineType cuisine_type = CuisineType::OTHER);
 
+    /**
+    * Destructor. Virtual, so deleting a dish through a Dish* (as Kitchen and MenuLoader do) also frees
+    the members of the derived class.
+    */
+    virtual ~Dish() = default;
+
+    //dishes are also stored by value (DishStore), so keep them copyable and movable
+    Dish(const Dish&) = default;
+    Dish(Dish&&) = default;
+    Dish& operator=(const Dish&) = default;
+    Dish& operator=(Dish&&) = default;
+
     /**
     * Pure virtual function to display dish details.
     * Must be overridden by derived classes.
@@ -78,9 +91,9 @@ public:
     std::string getName() const;
 
     /**
-     * @return The list of ingredients used in the dish.
+     * @return The list of ingredients used in the dish (a reference, so nothing is copied).
      */
-    std::vector<std::string> getIngredients() const;
+    const std::vector<std::string>& getIngredients() const;
 
     /**
      * @return The preparation time in minutes.
@@ -97,6 +110,11 @@ public:
      */
     std::string getCuisineType() const;
 
+    /**
+     * @return The cuisine type of the dish as a CuisineType enum.
+     */
+    CuisineType getCuisineTypeEnum() const;
+
     // Mutators
     /**
      * Sets the name of the dish.
@@ -165,6 +183,15 @@ public:
     */
     bool operator!=(const Dish& rhs) const; // Overloading the != operator
 
+protected:
+    /**
+    * Used by the dietary accommodations: rewrites the ingredients in place in one pass with
+    DietaryRules::rewrite.
+    * @param replace Classes whose first two ingredients become "Beans" and "Mushrooms"; later ones are removed.
+    * @param drop Classes whose ingredients are removed.
+    */
+    void applyIngredientRules(uint8_t replace, uint8_t drop);
+
 private:
     std::string name_;
     std::vector<std::string> ingredients_;
@@ -0,0 +1,85 @@
+/**
+ * @file DishStore.cpp
+ * @brief This file contains the implementation of the DishStore class.
+ *
+ *The bulk passes visit each variant with a generic lambda and call the member through the dish's own
+ *class (value.Type::display()), so the call is bound at compile time instead of through the vtable.
+ */
+
+#include "DishStore.hpp"
+#include "MenuLoader.hpp"
+#include <iostream>
+#include <type_traits>
+#include <utility>
+
+DishStore::DishStore() {}
+
+DishStore::DishStore(const std::string& filename, unsigned threads) {
+    MenuLoader menu(filename); // throws std::invalid_argument if the file cannot be opened
+    menu.parseParallel(menu.body(), dishes_, threads);
+}
+
+void DishStore::add(Entry dish) {
+    dishes_.push_back(std::move(dish));
+}
+
+bool DishStore::add(const Dish& dish) {
+    if (const Appetizer* appetizer = dynamic_cast<const Appetizer*>(&dish)) {
+        dishes_.emplace_back(*appetizer);
+    } else if (const MainCourse* main_course = dynamic_cast<const MainCourse*>(&dish)) {
+        dishes_.emplace_back(*main_course);
+    } else if (const Dessert* dessert = dynamic_cast<const Dessert*>(&dish)) {
+        dishes_.emplace_back(*dessert);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+int DishStore::getCurrentSize() const {
+    return static_cast<int>(dishes_.size());
+}
+
+bool DishStore::isEmpty() const {
+    return dishes_.empty();
+}
+
+const DishStore::Entry& DishStore::at(int index) const {
+    return dishes_[index];
+}
+
+DishStore::Entry& DishStore::at(int index) {
+    return dishes_[index];
+}
+
+const Dish& DishStore::dishAt(int index) const {
+    return std::visit([](const auto& value) -> const Dish& { return value; }, dishes_[index]);
+}
+
+void DishStore::reserve(std::size_t count) {
+    dishes_.reserve(count);
+}
+
+void DishStore::clear() {
+    dishes_.clear();
+}
+
+void DishStore::dietaryAdjustment(Dish::DietaryRequest request) {
+    for (Entry& dish : dishes_) {
+        std::visit([&request](auto& value) {
+            using Type = std::decay_t<decltype(value)>;
+            value.Type::dietaryAccommodations(request);
+        }, dish);
+    }
+}
+
+void DishStore::displayMenu() const {
+    for (const Entry& dish : dishes_) {
+        std::visit([](const auto& value) {
+            using Type = std::decay_t<decltype(value)>;
+            value.Type::display();
+        }, dish);
+    }
+    //the dishes write plain newlines, so flush once for the whole menu
+    std::cout << std::flush;
+}
@@ -0,0 +1,108 @@
+/**
+ * @file DishStore.hpp
+ * @brief This file contains the definition of the DishStore class.
+ *
+ *A DishStore holds dishes by value in one contiguous array of std::variant<Appetizer, MainCourse, Dessert>,
+ *instead of as Dish* to separate heap objects like Kitchen does. Bulk passes such as dietaryAdjustment and
+ *displayMenu walk the array in order and call each dish's own function through std::visit, with no pointer
+ *to follow and no virtual call per dish.
+ */
+
+#ifndef DISH_STORE_HPP
+#define DISH_STORE_HPP
+
+#include "Dish.hpp"
+#include "Appetizer.hpp"
+#include "Dessert.hpp"
+#include "MainCourse.hpp"
+#include <cstddef>
+#include <string>
+#include <variant>
+#include <vector>
+
+class DishStore {
+    public:
+        using Entry = std::variant<Appetizer, MainCourse, Dessert>;
+
+        /**
+        * Default constructor.
+        * @post The store is empty.
+        */
+        DishStore();
+
+        /**
+        * Parameterized constructor.
+        * @param filename The name of the input CSV file containing dish information.
+        * @param threads The number of threads used to parse the file (default 1;
+        0 uses one per hardware thread). Dishes are stored in file order either way.
+        * @pre The CSV file must be properly formatted.
+        * @post Every dish in the file is stored by value, duplicates included.
+        * @throw std::invalid_argument if the file cannot be opened.
+        */
+        explicit DishStore(const std::string& filename, unsigned threads = 1);
+
+        /**
+        * @param dish The dish to add at the end.
+        */
+        void add(Entry dish);
+
+        /**
+        * Adds a copy of a dish held through its base class, e.g. one of a Kitchen's dishes.
+        * @param dish An Appetizer, MainCourse or Dessert.
+        * @return True if the dish was copied; false if it is none of the three.
+        */
+        bool add(const Dish& dish);
+
+        /**
+        * @return The number of dishes in the store.
+        */
+        int getCurrentSize() const;
+
+        /**
+        * @return True if the store holds no dishes.
+        */
+        bool isEmpty() const;
+
+        /**
+        * @param index The position of a dish, 0 being the first added.
+        * @pre 0 <= index < getCurrentSize().
+        * @return The dish at that position.
+        */
+        const Entry& at(int index) const;
+        Entry& at(int index);
+
+        /**
+        * @param index The position of a dish.
+        * @pre 0 <= index < getCurrentSize().
+        * @return The dish at that position, seen through its base class.
+        */
+        const Dish& dishAt(int index) const;
+
+        /**
+        * Reserves room so that adding up to count dishes does not reallocate.
+        */
+        void reserve(std::size_t count);
+
+        /**
+        * @post The store is empty.
+        */
+        void clear();
+
+        /**
+        * Adjusts every dish based on the specified dietary accommodation.
+        * @param request A DietaryRequest structure specifying the dietary accommodations.
+        * @post Each dish's own dietaryAccommodations() has been applied to it, in order.
+        */
+        void dietaryAdjustment(Dish::DietaryRequest request);
+
+        /**
+        * Displays every dish in the store.
+        * @post Each dish's own display() has been called, in order.
+        */
+        void displayMenu() const;
+
+    private:
+        std::vector<Entry> dishes_;
+};
+
+#endif // DISH_STORE_HPP
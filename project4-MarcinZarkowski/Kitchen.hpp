@@ -19,6 +19,8 @@
 #include "Dish.hpp"
 // for round
 #include <cmath>
+#include <functional>
+#include <vector>
 
 class Kitchen : public ArrayBag<Dish*> {
     public:
@@ -26,11 +28,14 @@ class Kitchen : public ArrayBag<Dish*> {
         * Parameterized constructor.
         * @param filename The name of the input CSV file containing dish
         information.
+        * @param threads The number of threads used to parse the file (default 1;
+        0 uses one per hardware thread). Dishes are added in file order either way.
         * @pre The CSV file must be properly formatted.
         * @post Initializes the kitchen by reading dishes from the CSV file and
-        storing them as `Dish*`.
+        storing them as `Dish*`, in file order.
+        * @throw std::invalid_argument if the file cannot be opened.
         */
-        Kitchen(const std::string& filename);
+        Kitchen(const std::string& filename, unsigned threads = 1);
         Kitchen();
 
         /**
@@ -56,7 +61,27 @@ class Kitchen : public ArrayBag<Dish*> {
         int elaborateDishCount() const;
         double calculateElaboratePercentage() const;
         int tallyCuisineTypes(const std::string& cuisine_type) const;
+
+        /**
+        * Releases every dish for which the predicate returns true, in a single pass.
+        * @param predicate Called once for each dish in the kitchen.
+        * @post The released dishes are removed from the kitchen and the statistics,
+        and the remaining dishes keep their order. The kitchen no longer owns
+        the released dishes.
+        * @return The released dishes, in the order they were stored.
+        */
+        std::vector<Dish*> releaseDishes(const std::function<bool(const Dish*)>& predicate);
+
+        /**
+        * Releases and deletes every dish with a preparation time below prep_time.
+        * @return The number of dishes released.
+        */
         int releaseDishesBelowPrepTime(const int& prep_time);
+
+        /**
+        * Releases and deletes every dish with the given cuisine type.
+        * @return The number of dishes released.
+        */
         int releaseDishesOfCuisineType(const std::string& cuisine_type);
         void kitchenReport() const;
 
@@ -67,8 +92,28 @@ class Kitchen : public ArrayBag<Dish*> {
         */
         ~Kitchen();
     private:
+        // every aggregate below is kept up to date by newOrder, serveDish and
+        // dietaryAdjustment, so the statistics never rescan the dishes
         int total_prep_time_;
         int count_elaborate_;
+        static const int CUISINE_COUNT = Dish::CuisineType::OTHER + 1;
+        int cuisine_counts_[CUISINE_COUNT]; // number of dishes of each CuisineType
+
+        /**
+        * @return True if the dish has at least 5 ingredients and takes at least 60 minutes.
+        */
+        static bool isElaborate(const Dish* dish);
+
+        /**
+        * Adds (sign = 1) or removes (sign = -1) a dish's contribution to the aggregates.
+        */
+        void countDish(const Dish* dish, int sign);
+
+        /**
+        * Deletes dishes returned by releaseDishes().
+        * @return The number of dishes deleted.
+        */
+        static int deleteDishes(const std::vector<Dish*>& dishes);
     
 };
 
@@ -10,7 +10,8 @@
  */
 
 #include "MainCourse.hpp"
-#include <set>
+#include "DietaryRules.hpp"
+#include <algorithm>
 /**
  * Default constructor.
  * Initializes all private members with default values.
@@ -206,62 +207,25 @@ involves gluten.
 `PASTA`, `BREAD`, `STARCHES`.
 */
 void MainCourse::dietaryAccommodations(Dish::DietaryRequest request) {
-    std::set<std::string> meats = {"Meat", "Chicken", "Fish", "Beef", "Pork", "Lamb", "Shrimp", "Bacon"};
-    std::set<std::string> dairy = {"Milk", "Eggs", "Cheese", "Butter", "Cream", "Yogurt"};
-    std::set<Category> gluten = {GRAIN, PASTA, BREAD, STARCHES};
-    std::vector<std::string> meat_sub = {"Beans", "Mushrooms"};
-    int meat_replaced_count = 0;
+    if (request.vegetarian || request.vegan) {
+        protein_type_ = "Tofu";
 
-    if (request.vegetarian || request.gluten_free || request.vegan) {
-        
-        std::vector<std::string> ingredients = getIngredients();
-        
-        size_t i = 0;
-
-        // Handle vegetarian and vegan requests
-        if (request.vegetarian || request.vegan) {
-            protein_type_ = "Tofu";
-
-            //loop through ingredients
-            while (i < ingredients.size()) {
+        //one pass over the ingredients: the first two meats become Beans and Mushrooms and the rest are
+        //removed, and dairy and egg are removed for vegan
+        applyIngredientRules(request.vegetarian ? DietaryRules::MEAT : 0,
+                             request.vegan ? DietaryRules::DAIRY_OR_EGG : 0);
+    }
 
-                // Handle vegetarian ingredients
-                if (request.vegetarian && (meats.find(ingredients[i]) != meats.end())) {
-                    if (meat_replaced_count < 2) {
-                        ingredients[i] = meat_sub[meat_replaced_count];
-                        meat_replaced_count++;
-                    } else {
-                        ingredients.erase(ingredients.begin() + i); //remove ingredient and shift others down (keeps order intact since only first and second instances of meat should be changed to Beans and Mushrooms)  
-                    }
-                } 
-                
-                // Handle vegan ingredients
-                else if (request.vegan && (dairy.find(ingredients[i]) != dairy.end())) {      
-                    ingredients.erase(ingredients.begin() + i); //remove ingredient and shift others down (keeps order intact since only first and second instances of meat should be changed to Beans and Mushrooms)
-                }
-                else{
-                    i++; // Increment after checks
-                }
-            }
-            setIngredients(ingredients); // Set modified ingredients
-        }
-       
-        // Handle gluten-free side dishes
-        if (request.gluten_free) {
-            gluten_free_ = true;
-            std::vector<SideDish> side_dishes = getSideDishes();
-           
-            size_t side_i = 0;
-            while (side_i < side_dishes.size()) {
-                if (gluten.find(side_dishes[side_i].category) != gluten.end()) {                
-                   side_dishes.erase(side_dishes.begin() + side_i); //remove ingredient and shift others down (keeps order intact since only first and second instances of meat should be changed to Beans and Mushrooms)
-                   
-                }
-                else{
-                    side_i++; 
-                } 
-            }
-            side_dishes_ = side_dishes; // Set modified side dishes
-        }    
+    // Handle gluten-free side dishes
+    if (request.gluten_free) {
+        gluten_free_ = true;
+        side_dishes_.erase(std::remove_if(side_dishes_.begin(), side_dishes_.end(),
+                                          [](const SideDish& side) { return containsGluten(side.category); }),
+                           side_dishes_.end());
     }
 }
+
+bool MainCourse::containsGluten(Category category) {
+    static const unsigned GLUTEN_CATEGORIES = (1u << GRAIN) | (1u << PASTA) | (1u << BREAD) | (1u << STARCHES);
+    return (GLUTEN_CATEGORIES >> category) & 1u;
+}
@@ -164,6 +164,9 @@ private:
     std::string protein_type_; ///< The type of protein used in the main course.
     std::vector<SideDish> side_dishes_; ///< The side dishes served with the main course.
     bool gluten_free_; ///< Flag indicating if the main course is gluten-free.
+
+    // true for the side dish categories a gluten-free request removes: GRAIN, PASTA, BREAD, STARCHES
+    static bool containsGluten(Category category);
 };
 
 #endif // MAINCOURSE_HPP
\ No newline at end of file
@@ -0,0 +1,48 @@
+/**
+ * @file MappedFile.cpp
+ * @brief This file contains the implementation of the MappedFile class.
+ *
+ *Uses POSIX mmap so the kernel pages the file in as it is read, instead of copying it through a buffer.
+ */
+
+#include "MappedFile.hpp"
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const std::string& filename) : data_(nullptr), size_(0) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::invalid_argument("Could not open file: " + filename);
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) < 0) {
+        close(fd);
+        throw std::invalid_argument("Could not open file: " + filename);
+    }
+
+    size_ = static_cast<std::size_t>(info.st_size);
+    if (size_ > 0) { // mmap rejects empty mappings, an empty file just has no data
+        void* mapping = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            close(fd);
+            throw std::invalid_argument("Could not map file: " + filename);
+        }
+        madvise(mapping, size_, MADV_SEQUENTIAL); // only a hint, so failure is ignored
+        data_ = static_cast<const char*>(mapping);
+    }
+    close(fd); // the mapping stays valid after the descriptor is closed
+}
+
+MappedFile::~MappedFile() {
+    if (data_) {
+        munmap(const_cast<char*>(data_), size_);
+    }
+}
+
+std::string_view MappedFile::data() const {
+    return std::string_view(data_, size_);
+}
@@ -0,0 +1,45 @@
+/**
+ * @file MappedFile.hpp
+ * @brief This file contains the definition of the MappedFile class.
+ *
+ *A MappedFile maps a whole file read-only into memory so it can be parsed in place
+ *without copying it through a stream. The mapping is released when the object is destroyed.
+ */
+
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <string>
+#include <string_view>
+#include <cstddef>
+
+class MappedFile {
+    public:
+        /**
+        * Maps the file into memory.
+        * @param filename The name of the file to map.
+        * @post The contents of the file are readable through data().
+        * @throw std::invalid_argument if the file cannot be opened or mapped.
+        */
+        explicit MappedFile(const std::string& filename);
+
+        /**
+        * Destructor.
+        * @post Unmaps the file.
+        */
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /**
+        * @return The contents of the file (empty for an empty file).
+        */
+        std::string_view data() const;
+
+    private:
+        const char* data_;
+        std::size_t size_;
+};
+
+#endif // MAPPED_FILE_HPP
@@ -0,0 +1,319 @@
+/**
+ * @file MenuLoader.cpp
+ * @brief This file contains the implementation of the MenuLoader class.
+ *
+ *Fields are split with string_view and numbers are parsed with from_chars, so a line is read
+ *without any stream or temporary string. The parsing rules match the original getline based reader:
+ *an empty trailing field is dropped, missing fields keep their defaults and unknown enum names fall back
+ *to the same default values.
+ */
+
+#include "MenuLoader.hpp"
+#include "Appetizer.hpp"
+#include "Dessert.hpp"
+#include "MainCourse.hpp"
+#include <cctype>
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace {
+
+// moves a parsed dish into the form the caller stores
+void store(DishStore::Entry&& dish, std::vector<Dish*>& dishes) {
+    dishes.push_back(std::visit([](auto& value) -> Dish* {
+        return new std::decay_t<decltype(value)>(std::move(value));
+    }, dish));
+}
+
+void store(DishStore::Entry&& dish, std::vector<DishStore::Entry>& dishes) {
+    dishes.push_back(std::move(dish));
+}
+
+// drops dishes[first..] after a failed parse; heap dishes are deleted first
+void discard(std::vector<Dish*>& dishes, std::size_t first) {
+    for (std::size_t i = first; i < dishes.size(); i++) {
+        delete dishes[i];
+    }
+    dishes.resize(first);
+}
+
+void discard(std::vector<DishStore::Entry>& dishes, std::size_t first) {
+    dishes.erase(dishes.begin() + first, dishes.end());
+}
+
+// Splits the next field off rest at delimiter, like std::getline. Returns false once rest is used up.
+bool nextField(std::string_view& rest, char delimiter, std::string_view& field) {
+    if (rest.empty()) {
+        return false;
+    }
+    std::size_t end = rest.find(delimiter);
+    if (end == std::string_view::npos) {
+        field = rest;
+        rest = std::string_view();
+    } else {
+        field = rest.substr(0, end);
+        rest.remove_prefix(end + 1);
+    }
+    return true;
+}
+
+// Number fields accept what std::stoi/std::stof accept: leading blanks, an optional sign and trailing text.
+const char* numberStart(std::string_view field) {
+    const char* first = field.data();
+    const char* last = first + field.size();
+    while (first != last && std::isspace(static_cast<unsigned char>(*first))) {
+        first++;
+    }
+    if (first != last && *first == '+') {
+        first++;
+    }
+    return first;
+}
+
+template <class Number>
+Number parseNumber(std::string_view field) {
+    Number value = 0;
+    std::from_chars_result result = std::from_chars(numberStart(field), field.data() + field.size(), value);
+    if (result.ec == std::errc::result_out_of_range) {
+        throw std::out_of_range("Number out of range: " + std::string(field));
+    }
+    if (result.ec != std::errc()) {
+        throw std::invalid_argument("Invalid number: " + std::string(field));
+    }
+    return value;
+}
+
+Dish::CuisineType toCuisineType(std::string_view name) {
+    if (name == "ITALIAN") return Dish::CuisineType::ITALIAN;
+    if (name == "MEXICAN") return Dish::CuisineType::MEXICAN;
+    if (name == "CHINESE") return Dish::CuisineType::CHINESE;
+    if (name == "INDIAN") return Dish::CuisineType::INDIAN;
+    if (name == "AMERICAN") return Dish::CuisineType::AMERICAN;
+    if (name == "FRENCH") return Dish::CuisineType::FRENCH;
+    return Dish::CuisineType::OTHER;
+}
+
+Appetizer::ServingStyle toServingStyle(std::string_view name) {
+    if (name == "BUFFET") return Appetizer::ServingStyle::BUFFET;
+    if (name == "FAMILY_STYLE") return Appetizer::ServingStyle::FAMILY_STYLE;
+    return Appetizer::ServingStyle::PLATED;
+}
+
+MainCourse::CookingMethod toCookingMethod(std::string_view name) {
+    if (name == "BOILED") return MainCourse::CookingMethod::BOILED;
+    if (name == "BAKED") return MainCourse::CookingMethod::BAKED;
+    if (name == "FRIED") return MainCourse::CookingMethod::FRIED;
+    if (name == "STEAMED") return MainCourse::CookingMethod::STEAMED;
+    if (name == "RAW") return MainCourse::CookingMethod::RAW;
+    return MainCourse::CookingMethod::GRILLED;
+}
+
+MainCourse::Category toCategory(std::string_view name) {
+    if (name == "VEGETABLE") return MainCourse::Category::VEGETABLE;
+    if (name == "PASTA") return MainCourse::Category::PASTA;
+    if (name == "LEGUME") return MainCourse::Category::LEGUME;
+    if (name == "BREAD") return MainCourse::Category::BREAD;
+    if (name == "SALAD") return MainCourse::Category::SALAD;
+    if (name == "SOUP") return MainCourse::Category::SOUP;
+    if (name == "STARCHES") return MainCourse::Category::STARCHES;
+    return MainCourse::Category::GRAIN;
+}
+
+Dessert::FlavorProfile toFlavorProfile(std::string_view name) {
+    if (name == "UMAMI") return Dessert::FlavorProfile::UMAMI;
+    if (name == "BITTER") return Dessert::FlavorProfile::BITTER;
+    if (name == "SOUR") return Dessert::FlavorProfile::SOUR;
+    if (name == "SALTY") return Dessert::FlavorProfile::SALTY;
+    return Dessert::FlavorProfile::SWEET;
+}
+
+} // namespace
+
+MenuLoader::MenuLoader(const std::string& filename) : file_(filename) {}
+
+std::string_view MenuLoader::body() const {
+    std::string_view text = file_.data();
+    std::size_t header_end = text.find('\n');
+    if (header_end == std::string_view::npos) {
+        return std::string_view();
+    }
+    return text.substr(header_end + 1);
+}
+
+std::size_t MenuLoader::parse(std::string_view text, std::vector<Dish*>& dishes) const {
+    return parseLines(text, dishes);
+}
+
+std::size_t MenuLoader::parse(std::string_view text, std::vector<DishStore::Entry>& dishes) const {
+    return parseLines(text, dishes);
+}
+
+std::size_t MenuLoader::parseParallel(std::string_view text, std::vector<Dish*>& dishes, unsigned thread_count) const {
+    return parseChunks(text, dishes, thread_count);
+}
+
+std::size_t MenuLoader::parseParallel(std::string_view text, std::vector<DishStore::Entry>& dishes, unsigned thread_count) const {
+    return parseChunks(text, dishes, thread_count);
+}
+
+template<class T>
+std::size_t MenuLoader::parseLines(std::string_view text, std::vector<T>& dishes) const {
+    std::size_t first_new = dishes.size();
+    std::vector<std::string> ingredients; // reused for every line
+    std::string_view line;
+    try {
+        while (nextField(text, '\n', line)) {
+            std::optional<DishStore::Entry> dish = parseLine(line, ingredients);
+            if (dish) {
+                store(std::move(*dish), dishes);
+            }
+        }
+    } catch (...) {
+        //undo this call so the caller is not left owning half a menu
+        discard(dishes, first_new);
+        throw;
+    }
+    return dishes.size() - first_new;
+}
+
+template<class T>
+std::size_t MenuLoader::parseChunks(std::string_view text, std::vector<T>& dishes, unsigned thread_count) const {
+    if (thread_count == 0) {
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    //cut text into roughly equal chunks, moving each cut forward to just after the next line break
+    std::size_t chunk_count = std::min<std::size_t>(thread_count * CHUNKS_PER_THREAD, text.size() / MIN_CHUNK_SIZE + 1);
+    std::vector<std::string_view> chunks;
+    std::size_t chunk_start = 0;
+    for (std::size_t i = 1; i <= chunk_count && chunk_start < text.size(); i++) {
+        std::size_t cut = text.size();
+        if (i < chunk_count) {
+            cut = text.find('\n', std::max(chunk_start, text.size() * i / chunk_count));
+            cut = (cut == std::string_view::npos) ? text.size() : cut + 1;
+        }
+        chunks.push_back(text.substr(chunk_start, cut - chunk_start));
+        chunk_start = cut;
+    }
+    if (thread_count == 1 || chunks.size() <= 1) {
+        return parse(text, dishes);
+    }
+
+    //each chunk is parsed into its own vector; threads take the next unparsed chunk until none are left
+    std::vector<std::vector<T>> parsed(chunks.size());
+    std::vector<std::exception_ptr> errors(chunks.size());
+    std::atomic<std::size_t> next_chunk(0);
+    auto work = [&]() {
+        for (std::size_t i = next_chunk++; i < chunks.size(); i = next_chunk++) {
+            try {
+                parse(chunks[i], parsed[i]);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        }
+    };
+    std::vector<std::thread> pool;
+    for (std::size_t i = 1; i < std::min<std::size_t>(thread_count, chunks.size()); i++) {
+        pool.emplace_back(work);
+    }
+    work(); // the calling thread is part of the pool
+    for (std::thread& thread : pool) {
+        thread.join();
+    }
+
+    for (std::size_t i = 0; i < chunks.size(); i++) {
+        if (errors[i]) {
+            for (std::vector<T>& chunk_dishes : parsed) {
+                discard(chunk_dishes, 0);
+            }
+            std::rethrow_exception(errors[i]);
+        }
+    }
+
+    //merge in chunk order, which is file order
+    std::size_t count = 0;
+    for (const std::vector<T>& chunk_dishes : parsed) {
+        count += chunk_dishes.size();
+    }
+    dishes.reserve(dishes.size() + count);
+    for (std::vector<T>& chunk_dishes : parsed) {
+        dishes.insert(dishes.end(), std::make_move_iterator(chunk_dishes.begin()), std::make_move_iterator(chunk_dishes.end()));
+    }
+    return count;
+}
+
+std::optional<DishStore::Entry> MenuLoader::parseLine(std::string_view line, std::vector<std::string>& ingredients) {
+    if (!line.empty() && line.back() == '\r') { // tolerate files saved with CRLF line endings
+        line.remove_suffix(1);
+    }
+
+    std::string_view type, name, ingredient_list, attribute_list, field;
+    int preparation_time = 0;
+    float price = 0.0;
+    Dish::CuisineType cuisine = Dish::CuisineType::OTHER;
+
+    //the fields always come in the same order, so the counter tells which one is being read
+    int counter = 0;
+    while (nextField(line, ',', field)) {
+        switch (counter) {
+            case 0: type = field; break;
+            case 1: name = field; break;
+            case 2: ingredient_list = field; break;
+            case 3: preparation_time = parseNumber<int>(field); break;
+            case 4: price = parseNumber<float>(field); break;
+            case 5: cuisine = toCuisineType(field); break;
+            case 6: attribute_list = field; break;
+        }
+        counter++;
+    }
+
+    if (type != "APPETIZER" && type != "MAINCOURSE" && type != "DESSERT") {
+        return std::nullopt;
+    }
+
+    ingredients.clear();
+    while (nextField(ingredient_list, ';', field)) {
+        ingredients.emplace_back(field);
+    }
+
+    //the attributes depend on the dish type; only the first four are ever used
+    std::string_view attributes[4];
+    for (std::string_view& attribute : attributes) {
+        if (!nextField(attribute_list, ';', attribute)) {
+            break;
+        }
+    }
+
+    if (type == "APPETIZER") {
+        //serving style; spiciness level; vegetarian
+        return Appetizer(std::string(name), ingredients, preparation_time, price, cuisine,
+                         toServingStyle(attributes[0]), parseNumber<int>(attributes[1]), attributes[2] == "true");
+    }
+    if (type == "MAINCOURSE") {
+        //cooking method; protein; side dishes as name:category separated by |; gluten free
+        std::vector<MainCourse::SideDish> side_dishes;
+        std::string_view side_list = attributes[2], side;
+        while (nextField(side_list, '|', side)) {
+            std::string_view side_name, side_category;
+            nextField(side, ':', side_name);
+            nextField(side, ':', side_category);
+
+            MainCourse::SideDish side_dish;
+            side_dish.name = std::string(side_name);
+            side_dish.category = toCategory(side_category);
+            side_dishes.push_back(side_dish);
+        }
+        return MainCourse(std::string(name), ingredients, preparation_time, price, cuisine,
+                          toCookingMethod(attributes[0]), std::string(attributes[1]), side_dishes, attributes[3] == "true");
+    }
+    //flavor profile; sweetness level; contains nuts
+    return Dessert(std::string(name), ingredients, preparation_time, price, cuisine,
+                   toFlavorProfile(attributes[0]), parseNumber<int>(attributes[1]), attributes[2] == "true");
+}
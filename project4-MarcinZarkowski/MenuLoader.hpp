@@ -0,0 +1,103 @@
+/**
+ * @file MenuLoader.hpp
+ * @brief This file contains the definition of the MenuLoader class.
+ *
+ *The MenuLoader reads a dish CSV file (DishType,Name,Ingredients,PreparationTime,Price,CuisineType,AdditionalAttributes)
+ *and builds the matching Appetizer, MainCourse and Dessert objects, either on the heap (for Kitchen) or by value
+ *(for DishStore). The file is memory-mapped and tokenized in place, so no line or field is copied except the
+ *strings the dishes keep.
+ */
+
+#ifndef MENU_LOADER_HPP
+#define MENU_LOADER_HPP
+
+#include "Dish.hpp"
+#include "DishStore.hpp"
+#include "MappedFile.hpp"
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class MenuLoader {
+    public:
+        /**
+        * Opens and maps the CSV file.
+        * @param filename The name of the input CSV file containing dish information.
+        * @throw std::invalid_argument if the file cannot be opened.
+        */
+        explicit MenuLoader(const std::string& filename);
+
+        /**
+        * @return The dish lines of the file, i.e. everything after the header line.
+        */
+        std::string_view body() const;
+
+        /**
+        * Parses every line of text into a dish.
+        * @param text Complete CSV lines, e.g. body() or a part of it that starts and ends on a line boundary.
+        * @param dishes The vector the dishes are appended to, in the order they appear in text.
+        * @pre Every line is properly formatted. Lines with an unknown DishType are skipped.
+        * @post The caller owns the dynamically allocated dishes appended to dishes.
+        * @return The number of dishes appended.
+        * @throw std::invalid_argument if a number field cannot be parsed. Nothing is appended in that case.
+        */
+        std::size_t parse(std::string_view text, std::vector<Dish*>& dishes) const;
+
+        /**
+        * Parses every line of text into a dish held by value.
+        * @param text Complete CSV lines.
+        * @param dishes The vector the dishes are appended to, in the order they appear in text.
+        * @pre Every line is properly formatted. Lines with an unknown DishType are skipped.
+        * @return The number of dishes appended.
+        * @throw std::invalid_argument if a number field cannot be parsed. Nothing is appended in that case.
+        */
+        std::size_t parse(std::string_view text, std::vector<DishStore::Entry>& dishes) const;
+
+        /**
+        * Parses text like parse(), but splits it on line boundaries into chunks that are parsed on a pool of threads.
+        * @param text Complete CSV lines, e.g. body().
+        * @param dishes The vector the dishes are appended to, in the order they appear in text.
+        * @param thread_count The number of threads to parse with (0 uses one per hardware thread).
+        * @pre Every line is properly formatted.
+        * @post The caller owns the dynamically allocated dishes appended to dishes.
+        * @return The number of dishes appended.
+        * @throw The error of the first line that cannot be parsed. Nothing is appended in that case.
+        */
+        std::size_t parseParallel(std::string_view text, std::vector<Dish*>& dishes, unsigned thread_count) const;
+
+        /**
+        * Parses text like parse(), on a pool of threads, into dishes held by value.
+        * @param text Complete CSV lines, e.g. body().
+        * @param dishes The vector the dishes are appended to, in the order they appear in text.
+        * @param thread_count The number of threads to parse with (0 uses one per hardware thread).
+        * @pre Every line is properly formatted.
+        * @return The number of dishes appended.
+        * @throw The error of the first line that cannot be parsed. Nothing is appended in that case.
+        */
+        std::size_t parseParallel(std::string_view text, std::vector<DishStore::Entry>& dishes, unsigned thread_count) const;
+
+    private:
+        MappedFile file_;
+
+        // chunks per thread, so a thread that gets quick lines can pick up more work
+        static const unsigned CHUNKS_PER_THREAD = 4;
+        // below this many bytes per chunk, starting a thread costs more than it saves
+        static const std::size_t MIN_CHUNK_SIZE = 64 * 1024;
+
+        // the shared bodies of the two parse() and parseParallel() overloads; T is Dish* or DishStore::Entry
+        template<class T>
+        std::size_t parseLines(std::string_view text, std::vector<T>& dishes) const;
+        template<class T>
+        std::size_t parseChunks(std::string_view text, std::vector<T>& dishes, unsigned thread_count) const;
+
+        /**
+        * Builds the dish described by one CSV line.
+        * @param line The line, without its line terminator.
+        * @param ingredients Scratch vector reused between lines to hold the ingredient names.
+        * @return The dish, or nothing if the DishType is unknown.
+        */
+        static std::optional<DishStore::Entry> parseLine(std::string_view line, std::vector<std::string>& ingredients);
+};
+
+#endif // MENU_LOADER_HPP
@@ -0,0 +1,390 @@
+// Behaviour tests for the menu loader and the kitchen's bookkeeping. Each test writes or builds a small
+// menu, runs one path and checks what it leaves behind, malformed input included. Build and run with
+// `make check`: every failed check is printed and the program exits non-zero if there was one.
+
+#include "ArrayBag.hpp"
+#include "Kitchen.hpp"
+#include "MenuLoader.hpp"
+#include "Appetizer.hpp"
+#include "Dessert.hpp"
+#include "MainCourse.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cout << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+const char* const MENU_FILE = "test_menu.csv";
+const char* const HEADER = "DishType,Name,Ingredients,PreparationTime,Price,CuisineType,AdditionalAttributes\n";
+
+// writes the header and text to MENU_FILE byte for byte, so CRLF and a missing last newline are kept
+void writeMenu(const std::string& text) {
+    std::ofstream file(MENU_FILE, std::ios::binary | std::ios::trunc);
+    file << HEADER << text;
+}
+
+// every field a dish keeps, on one line, so two dishes compare equal only if they were read the same way
+std::string describe(const Dish& dish) {
+    std::ostringstream out;
+    out << dish.getName() << "|" << dish.getPrepTime() << "|" << dish.getPrice() << "|" << dish.getCuisineType() << "|";
+    for (const std::string& ingredient : dish.getIngredients()) {
+        out << ingredient << ";";
+    }
+    if (const Appetizer* appetizer = dynamic_cast<const Appetizer*>(&dish)) {
+        out << "|APPETIZER|" << appetizer->getServingStyle() << "|" << appetizer->getSpicinessLevel() << "|" << appetizer->isVegetarian();
+    } else if (const MainCourse* main_course = dynamic_cast<const MainCourse*>(&dish)) {
+        out << "|MAINCOURSE|" << main_course->getCookingMethod() << "|" << main_course->getProteinType() << "|";
+        for (const MainCourse::SideDish& side : main_course->getSideDishes()) {
+            out << side.name << ":" << side.category << ";";
+        }
+        out << "|" << main_course->isGlutenFree();
+    } else if (const Dessert* dessert = dynamic_cast<const Dessert*>(&dish)) {
+        out << "|DESSERT|" << dessert->getFlavorProfile() << "|" << dessert->getSweetnessLevel() << "|" << dessert->containsNuts();
+    }
+    return out.str();
+}
+
+std::vector<std::string> describeAll(const std::vector<Dish*>& dishes) {
+    std::vector<std::string> described;
+    for (const Dish* dish : dishes) {
+        described.push_back(describe(*dish));
+    }
+    return described;
+}
+
+std::vector<std::string> describeAll(const std::vector<DishStore::Entry>& dishes) {
+    std::vector<std::string> described;
+    for (const DishStore::Entry& entry : dishes) {
+        described.push_back(std::visit([](const Dish& dish) { return describe(dish); }, entry));
+    }
+    return described;
+}
+
+void deleteAll(std::vector<Dish*>& dishes) {
+    for (Dish* dish : dishes) {
+        delete dish;
+    }
+    dishes.clear();
+}
+
+// every field of each dish type, CRLF lines, an unknown type, a blank line and a last line without a newline
+void testParseFields() {
+    writeMenu("APPETIZER,Nachos,Chips;Cheese,15,6.99,MEXICAN,BUFFET;3;true\r\n"
+              "DRINK,Lemonade,Lemon;Sugar,5,2.50,AMERICAN,COLD\n"
+              "\n"
+              "MAINCOURSE,Lasagna,Pasta;Beef;Cheese,60,14.5,ITALIAN,BAKED;Beef;Garlic Bread:BREAD|Salad:SALAD;false\n"
+              "DESSERT,Mochi,Rice;Sugar,20,4.25,CHINESE,UMAMI;6;true");
+    MenuLoader menu(MENU_FILE);
+    std::vector<Dish*> dishes;
+    check(menu.parse(menu.body(), dishes) == 3, "parse: the unknown type and the blank line are skipped");
+    std::vector<std::string> expected = {
+        describe(Appetizer("Nachos", {"Chips", "Cheese"}, 15, 6.99f, Dish::MEXICAN, Appetizer::BUFFET, 3, true)),
+        describe(MainCourse("Lasagna", {"Pasta", "Beef", "Cheese"}, 60, 14.5f, Dish::ITALIAN, MainCourse::BAKED, "Beef",
+                            {{"Garlic Bread", MainCourse::BREAD}, {"Salad", MainCourse::SALAD}}, false)),
+        describe(Dessert("Mochi", {"Rice", "Sugar"}, 20, 4.25f, Dish::CHINESE, Dessert::UMAMI, 6, true)),
+    };
+    check(describeAll(dishes) == expected, "parse: every field is read, CRLF and a missing last newline included");
+    deleteAll(dishes);
+}
+
+// fields missing from the end of a line keep their defaults, unknown enum names fall back to the defaults
+// and number fields take what std::stoi would
+void testParseMissingFieldsAndDefaults() {
+    writeMenu("MAINCOURSE,Rice Bowl,Rice,10,5.00\n"
+              "MAINCOURSE,Stew,Beef;Carrot,90,11.00,JAPANESE\n"
+              "APPETIZER,Olives,Olives, 7min,+3.5,SPANISH,BOWL;2;yes\n");
+    MenuLoader menu(MENU_FILE);
+    std::vector<Dish*> dishes;
+    menu.parse(menu.body(), dishes);
+    std::vector<std::string> expected = {
+        describe(MainCourse("Rice Bowl", {"Rice"}, 10, 5.0f, Dish::OTHER, MainCourse::GRILLED, "", {}, false)),
+        describe(MainCourse("Stew", {"Beef", "Carrot"}, 90, 11.0f, Dish::OTHER, MainCourse::GRILLED, "", {}, false)),
+        describe(Appetizer("Olives", {"Olives"}, 7, 3.5f, Dish::OTHER, Appetizer::PLATED, 2, false)),
+    };
+    check(describeAll(dishes) == expected, "parse: missing cuisine and attributes keep their defaults");
+    deleteAll(dishes);
+}
+
+// a number field that is not a number rejects the whole call, and nothing from it is kept
+void testParseMalformedNumber() {
+    const std::string good = "DESSERT,Flan,Eggs;Sugar,30,5.00,FRENCH,SWEET;8;false\n";
+    const std::vector<std::string> bad_lines = {
+        "APPETIZER,Bad Time,Bread,soon,4.00,ITALIAN,PLATED;1;false\n",
+        "APPETIZER,Bad Price,Bread,10,free,ITALIAN,PLATED;1;false\n",
+        "APPETIZER,Bad Spice,Bread,10,4.00,ITALIAN,PLATED;hot;false\n",
+        "DESSERT,No Sweetness,Sugar,10,4.00,FRENCH\n",
+        "APPETIZER,Huge,Bread,99999999999,4.00,ITALIAN,PLATED;1;false\n",
+    };
+    for (const std::string& bad : bad_lines) {
+        writeMenu(good + bad + good);
+        MenuLoader menu(MENU_FILE);
+        std::vector<Dish*> dishes = {new Dessert()};
+        bool thrown = false;
+        try {
+            menu.parse(menu.body(), dishes);
+        } catch (const std::logic_error&) { // std::invalid_argument or std::out_of_range
+            thrown = true;
+        }
+        check(thrown && dishes.size() == 1, "parse: rejects " + bad.substr(0, bad.size() - 1) + " and keeps nothing");
+        deleteAll(dishes);
+    }
+}
+
+// a menu big enough to be cut into many chunks, with lines of varying length so the cuts fall mid-line
+std::string bigMenu(int lines) {
+    static const char* const cuisines[] = {"ITALIAN", "MEXICAN", "CHINESE", "INDIAN", "AMERICAN", "FRENCH", "THAI"};
+    std::string text;
+    for (int i = 0; i < lines; i++) {
+        std::string name = "Dish " + std::to_string(i) + std::string(i % 37, 'x');
+        std::string price = std::to_string(i % 50) + "." + std::to_string(i % 100);
+        std::string cuisine = cuisines[i % 7];
+        switch (i % 4) {
+            case 0: text += "APPETIZER," + name + ",Bread;Oil," + std::to_string(i % 90) + "," + price + "," + cuisine + ",FAMILY_STYLE;" + std::to_string(i % 10) + ";true"; break;
+            case 1: text += "MAINCOURSE," + name + ",Rice;Beef;Peas;Salt;Oil," + std::to_string(i % 120) + "," + price + "," + cuisine + ",FRIED;Beef;Fries:STARCHES|Soup:SOUP;" + (i % 3 ? "true" : "false"); break;
+            case 2: text += "DESSERT," + name + ",Sugar," + std::to_string(i % 60) + "," + price + "," + cuisine + ",SOUR;" + std::to_string(i % 10) + ";false"; break;
+            case 3: text += "SIDE," + name + ",Salt,1,1.00,OTHER,NONE"; break;
+        }
+        text += (i % 5 == 0) ? "\r\n" : "\n";
+    }
+    text.pop_back(); // the last line has no newline
+    return text;
+}
+
+// any number of threads gives the same dishes in the same order as one thread, for both dish forms
+void testParseParallelMatchesSerial() {
+    writeMenu(bigMenu(12000)); // about 1 MB, so up to 16 chunks
+    MenuLoader menu(MENU_FILE);
+
+    std::vector<Dish*> serial;
+    menu.parse(menu.body(), serial);
+    std::vector<std::string> expected = describeAll(serial);
+    check(expected.size() == 9000, "parse: the big menu has 9000 dishes");
+    deleteAll(serial);
+
+    for (unsigned threads : {1u, 2u, 3u, 4u, 7u, 0u}) {
+        std::vector<Dish*> dishes = {new Dessert()};
+        std::size_t count = menu.parseParallel(menu.body(), dishes, threads);
+        std::vector<std::string> parsed = describeAll(dishes);
+        parsed.erase(parsed.begin());
+        check(count == expected.size() && parsed == expected,
+              "parseParallel(" + std::to_string(threads) + " threads): same dishes, same order, after what was there");
+        deleteAll(dishes);
+
+        std::vector<DishStore::Entry> entries;
+        menu.parseParallel(menu.body(), entries, threads);
+        check(describeAll(entries) == expected, "parseParallel(" + std::to_string(threads) + " threads): same entries by value");
+    }
+}
+
+// a malformed number in any chunk rejects the whole parse and keeps nothing
+void testParseParallelMalformedNumber() {
+    std::string text = bigMenu(12000);
+    std::size_t middle = text.find('\n', text.size() / 2) + 1;
+    text.insert(middle, "DESSERT,Broken,Sugar,ten,1.00,FRENCH,SWEET;1;false\n");
+    writeMenu(text);
+    MenuLoader menu(MENU_FILE);
+    std::vector<Dish*> dishes = {new Dessert()};
+    bool thrown = false;
+    try {
+        menu.parseParallel(menu.body(), dishes, 4);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    check(thrown && dishes.size() == 1, "parseParallel: a malformed number in one chunk rejects the whole menu");
+    deleteAll(dishes);
+}
+
+// an ArrayBag whose storage and index can be checked against each other
+class CheckedBag : public ArrayBag<int> {
+    public:
+        // whether the bag holds exactly `expected`, in that order, and the index (if enabled) maps each
+        // item to its position and nothing else
+        bool holds(const std::vector<int>& expected) const {
+            if (items_ != expected || item_count_ != static_cast<int>(expected.size())) {
+                return false;
+            }
+            if (!index_) {
+                return true;
+            }
+            if (index_->size() != expected.size()) {
+                return false;
+            }
+            for (int i = 0; i < item_count_; i++) {
+                auto found = index_->find(items_[i]);
+                if (found == index_->end() || found->second != i) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        static int defaultCapacity() {
+            return DEFAULT_CAPACITY;
+        }
+};
+
+// growing past DEFAULT_CAPACITY, swap-removing the first, a middle and the last item, removeIf, clear and
+// adding again, with and without the index; the index must follow the items at every step
+void testArrayBagGrowsAndKeepsIndex() {
+    for (bool indexed : {false, true}) {
+        std::string name = indexed ? "ArrayBag (indexed): " : "ArrayBag: ";
+        CheckedBag bag;
+        if (indexed) {
+            bag.enableIndex();
+        }
+        std::vector<int> expected;
+        int count = CheckedBag::defaultCapacity() * 2 + 50;
+        bool added = true;
+        for (int i = 0; i < count; i++) {
+            added = bag.add(i) && added;
+            expected.push_back(i);
+        }
+        check(added && bag.getCurrentSize() == count && bag.holds(expected), name + "grows past DEFAULT_CAPACITY");
+        check(!bag.add(7) && bag.getFrequencyOf(7) == 1, name + "a duplicate is refused");
+
+        // remove moves the last item into the gap
+        for (int item : {0, 120, count - 2, count - 1}) {
+            auto position = std::find(expected.begin(), expected.end(), item);
+            *position = expected.back();
+            expected.pop_back();
+            check(bag.remove(item) && bag.holds(expected), name + "remove(" + std::to_string(item) + ")");
+        }
+        check(!bag.remove(120) && !bag.contains(120) && bag.contains(121), name + "a removed item is gone");
+
+        std::vector<int> removed = bag.removeIf([](const int& item) { return item % 3 == 0; });
+        std::vector<int> expected_removed;
+        std::vector<int> kept;
+        for (int item : expected) {
+            (item % 3 == 0 ? expected_removed : kept).push_back(item);
+        }
+        expected = kept;
+        check(removed == expected_removed && bag.holds(expected), name + "removeIf keeps the others in order");
+        check(!bag.contains(3) && bag.contains(4) && bag.getFrequencyOf(4) == 1, name + "lookups after removeIf");
+
+        bag.clear();
+        check(bag.isEmpty() && bag.holds({}) && !bag.contains(4), name + "clear empties the bag");
+        check(bag.add(4) && bag.add(1000) && bag.holds({4, 1000}) && bag.contains(1000), name + "adding after clear");
+    }
+}
+
+// a Kitchen whose running totals can be compared with a recount of its dishes
+class CheckedKitchen : public Kitchen {
+    public:
+        using Kitchen::Kitchen;
+
+        // whether every statistic equals what a full pass over the dishes gives
+        bool totalsMatchRecount() const {
+            static const char* const cuisines[] = {"ITALIAN", "MEXICAN", "CHINESE", "INDIAN", "AMERICAN", "FRENCH", "OTHER"};
+            int prep_time = 0;
+            int elaborate = 0;
+            for (const Dish* dish : items_) {
+                prep_time += dish->getPrepTime();
+                if (dish->getIngredients().size() >= 5 && dish->getPrepTime() >= 60) {
+                    elaborate++;
+                }
+            }
+            bool match = getPrepTimeSum() == prep_time && elaborateDishCount() == elaborate;
+            for (const char* cuisine : cuisines) {
+                int count = static_cast<int>(std::count_if(items_.begin(), items_.end(),
+                    [cuisine](const Dish* dish) { return dish->getCuisineType() == cuisine; }));
+                match = match && tallyCuisineTypes(cuisine) == count;
+            }
+            return match;
+        }
+};
+
+// the running totals equal a brute-force recount after every kind of change, including dietary
+// adjustments that drop ingredients and so change which dishes are elaborate
+void testKitchenTotalsMatchRecount() {
+    CheckedKitchen kitchen("Dishes.csv", 4);
+    check(kitchen.getCurrentSize() > 0 && kitchen.totalsMatchRecount(), "Kitchen: totals after loading");
+
+    // elaborate until the meat and gluten are taken out
+    Dish* feast = new MainCourse("Feast", {"Beef", "Pork", "Lamb", "Chicken", "Bread", "Flour"}, 90, 30.0,
+                                 Dish::FRENCH, MainCourse::BAKED, "Beef", {}, false);
+    Dish* salad = new Appetizer("Salad", {"Lettuce"}, 5, 4.0, Dish::ITALIAN, Appetizer::PLATED, 0, true);
+    check(kitchen.newOrder(feast) && kitchen.newOrder(salad) && kitchen.totalsMatchRecount(), "Kitchen: totals after newOrder");
+    int elaborate = kitchen.elaborateDishCount();
+
+    check(kitchen.serveDish(salad) && kitchen.totalsMatchRecount(), "Kitchen: totals after serveDish");
+    delete salad;
+
+    std::vector<Dish*> released = kitchen.releaseDishes([](const Dish* dish) { return dish->getPrepTime() < 20; });
+    check(!released.empty() && kitchen.totalsMatchRecount(), "Kitchen: totals after releaseDishes");
+    for (Dish* dish : released) {
+        delete dish;
+    }
+
+    Dish::DietaryRequest request = {true, true, true, true, true, true};
+    kitchen.dietaryAdjustment(request);
+    check(kitchen.totalsMatchRecount(), "Kitchen: totals after dietaryAdjustment");
+    check(kitchen.elaborateDishCount() < elaborate, "Kitchen: dietaryAdjustment makes the feast no longer elaborate");
+}
+
+// an appetizer that counts its destructions
+class CountedAppetizer : public Appetizer {
+    public:
+        static int destroyed;
+        CountedAppetizer(const std::string& name, int prep_time, Dish::CuisineType cuisine)
+            : Appetizer(name, {"Bread"}, prep_time, 1.0, cuisine, Appetizer::PLATED, 0, false) {}
+        ~CountedAppetizer() override {
+            destroyed++;
+        }
+};
+int CountedAppetizer::destroyed = 0;
+
+// the release wrappers delete what they release, and the kitchen deletes the rest
+void testReleaseWrappersDeleteDishes() {
+    CountedAppetizer::destroyed = 0;
+    {
+        Kitchen kitchen;
+        kitchen.newOrder(new CountedAppetizer("Quick", 5, Dish::ITALIAN));
+        kitchen.newOrder(new CountedAppetizer("Slow", 50, Dish::ITALIAN));
+        kitchen.newOrder(new CountedAppetizer("Quicker", 2, Dish::MEXICAN));
+        kitchen.newOrder(new CountedAppetizer("Tacos", 30, Dish::MEXICAN));
+        kitchen.newOrder(new CountedAppetizer("Soup", 40, Dish::FRENCH));
+
+        check(kitchen.releaseDishesBelowPrepTime(10) == 2 && CountedAppetizer::destroyed == 2 && kitchen.getCurrentSize() == 3,
+              "releaseDishesBelowPrepTime deletes the released dishes");
+        check(kitchen.releaseDishesOfCuisineType("ITALIAN") == 1 && CountedAppetizer::destroyed == 3 && kitchen.getCurrentSize() == 2,
+              "releaseDishesOfCuisineType deletes the released dishes");
+        check(kitchen.releaseDishesOfCuisineType("CHINESE") == 0 && CountedAppetizer::destroyed == 3,
+              "releaseDishesOfCuisineType with no match deletes nothing");
+    }
+    check(CountedAppetizer::destroyed == 5, "~Kitchen deletes the dishes still in the kitchen");
+}
+
+} // namespace
+
+int main() {
+    testParseFields();
+    testParseMissingFieldsAndDefaults();
+    testParseMalformedNumber();
+    testParseParallelMatchesSerial();
+    testParseParallelMalformedNumber();
+    std::remove(MENU_FILE);
+    testArrayBagGrowsAndKeepsIndex();
+    testKitchenTotalsMatchRecount();
+    testReleaseWrappersDeleteDishes();
+
+    if (failures > 0) {
+        std::cout << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All tests passed" << std::endl;
+    return 0;
+}